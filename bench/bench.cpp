@@ -0,0 +1,776 @@
+// Headless frame-time benchmark for swanGUI.h
+// Builds synthetic UIs on the HeadlessBackend, drives them with scripted input and reports
+// Update/Draw percentiles, heap allocations and draw-command counts per frame. No window or GPU needed.
+//
+// The bindings table runs a 1 kHz simulation thread that owns the values a panel of sliders shows and edits.
+// The console table runs worker threads that log into a Console while the UI thread draws it at 144 FPS.
+// The table 1M x 20 table scrolls and sorts a Table whose cells are formatted on demand.
+// The plot table streams samples into a Plot with 16 series of 1M points.
+// The assets table builds panels of thumbnails whose images load on the loader threads.
+//
+// Usage: bench [frames]
+//        bench --check-allocs    exits non-zero if an idle frame allocates after warm-up
+
+#include "swanGUI.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <thread>
+
+//every heap allocation goes through here so the frame loop can count them
+static size_t g_allocations= 0;
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"	//malloc/free behind replaced new/delete is fine
+#endif
+
+void* operator new(size_t size){
+	g_allocations++;
+	if(void *ptr= std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept{ std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept{ std::free(ptr); }
+
+struct Bindings{
+	std::deque<int> m_ints;
+	std::deque<float> m_floats;
+	std::deque<bool> m_bools;
+	std::deque<std::string> m_strings;
+	std::deque<SharedValue<int>> m_shared_ints;
+	std::deque<SharedValue<float>> m_shared_floats;
+	std::deque<SharedValue<bool>> m_shared_bools;
+	std::deque<SharedValue<Color>> m_shared_colors;
+};
+
+struct Scenario{
+	const char *m_name;
+	std::function<void(SwanGui&, Bindings&)> m_build;
+};
+
+struct Result{
+	std::vector<double> m_update;
+	std::vector<double> m_draw;
+	double m_build_ms= 0;
+	double m_build_allocations= 0;
+	double m_allocations= 0;
+	double m_commands= 0;
+	double m_batches= 0;
+	double m_rasterized= 0;
+	double m_updated= 0;
+	double m_waiting= 0;
+};
+
+static void AddMixedElements(Panel& panel, Bindings& bindings, int count, int seed){
+	for(int i= 0; i< count; i++){
+		std::string label= "Element " + std::to_string(seed + i);
+		switch(i % 5){
+			case 0: panel.addElement(std::make_shared<Button>(label, [](){})); break;
+			case 1: panel.addElement(std::make_shared<CheckBox>(label, bindings.m_bools.emplace_back(false))); break;
+			case 2: panel.addElement(std::make_shared<Slider>(label, bindings.m_ints.emplace_back(i % 100), 1, 0, 100)); break;
+			case 3: panel.addElement(std::make_shared<SliderF>(label, bindings.m_floats.emplace_back(0.5f), 0.01f, 0.0f, 1.0f)); break;
+			case 4: panel.addElement(std::make_shared<InputBox>(label, bindings.m_strings.emplace_back("longer than the sso buffer"), 16)); break;
+		}
+	}
+}
+
+//same mix, built in the panel's element arena
+static void EmplaceMixedElements(Panel& panel, Bindings& bindings, int count, int seed){
+	panel.reserveElements<Button>(count/5 + 1);
+	panel.reserveElements<CheckBox>(count/5 + 1);
+	panel.reserveElements<Slider>(count/5 + 1);
+	panel.reserveElements<SliderF>(count/5 + 1);
+	panel.reserveElements<InputBox>(count/5 + 1);
+	for(int i= 0; i< count; i++){
+		std::string label= "Element " + std::to_string(seed + i);
+		switch(i % 5){
+			case 0: panel.emplaceElement<Button>(label, [](){}); break;
+			case 1: panel.emplaceElement<CheckBox>(label, bindings.m_bools.emplace_back(false)); break;
+			case 2: panel.emplaceElement<Slider>(label, bindings.m_ints.emplace_back(i % 100), 1, 0, 100); break;
+			case 3: panel.emplaceElement<SliderF>(label, bindings.m_floats.emplace_back(0.5f), 0.01f, 0.0f, 1.0f); break;
+			case 4: panel.emplaceElement<InputBox>(label, bindings.m_strings.emplace_back("longer than the sso buffer"), 16); break;
+		}
+	}
+}
+
+//mouse sweeps the screen, clicks every 30 frames, scrolls every 10 and types every 60
+static void ScriptInput(HeadlessBackend& backend, int frame){
+	float t= frame*0.05f;
+	backend.MoveMouse((Vector2){960.0f + 900.0f*sinf(t*1.3f), 540.0f + 500.0f*sinf(t*0.7f)});
+	if(frame % 30== 0) backend.PressButton(MOUSE_BUTTON_LEFT);
+	if(frame % 30== 2) backend.ReleaseButton(MOUSE_BUTTON_LEFT);
+	if(frame % 10== 0) backend.Scroll((frame/10) % 2 ? 1.0f : -1.0f);
+	if(frame % 60== 0){
+		backend.TypeChar('a' + (frame/60) % 26);
+		backend.PressKey(KEY_BACKSPACE);
+	}
+}
+
+static double Percentile(std::vector<double> samples, double p){
+	if(samples.empty()) return 0.0;
+	std::sort(samples.begin(), samples.end());
+	size_t index= std::min(samples.size() - 1, (size_t)(p*(samples.size() - 1) + 0.5));
+	return samples[index];
+}
+
+static Result Run(const Scenario& scenario, HeadlessBackend& backend, int frames){
+	using Clock= std::chrono::steady_clock;
+	Result result;
+	SwanGui gui;
+	Bindings bindings;
+	size_t build_allocations= g_allocations;
+	auto build_start= Clock::now();
+	scenario.m_build(gui, bindings);
+	result.m_build_ms= std::chrono::duration<double, std::milli>(Clock::now() - build_start).count();
+	result.m_build_allocations= (double)(g_allocations - build_allocations);
+
+	for(int frame= 0; frame< frames; frame++){
+		ScriptInput(backend, frame);
+		size_t allocations= g_allocations;
+
+		auto t0= Clock::now();
+		gui.Update();
+		auto t1= Clock::now();
+		gui.Draw();
+		auto t2= Clock::now();
+
+		result.m_update.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+		result.m_draw.push_back(std::chrono::duration<double, std::micro>(t2 - t1).count());
+		result.m_allocations+= g_allocations - allocations;
+		result.m_commands+= gui.GetFrameStats().draw_commands;
+		result.m_batches+= gui.GetFrameStats().draw_batches;
+		result.m_rasterized+= gui.GetFrameStats().panels_rasterized;
+		result.m_updated+= gui.GetFrameStats().elements_updated;
+		backend.EndFrame();
+	}
+	result.m_allocations/= frames;
+	result.m_commands/= frames;
+	result.m_batches/= frames;
+	result.m_rasterized/= frames;
+	result.m_updated/= frames;
+	return result;
+}
+
+//runs the input script for a while, then measures frames without any input: only panels and focused or
+//animating elements should be touched, and with idle pacing the frame loop should be allowed to wait for input
+static Result RunIdle(const Scenario& scenario, HeadlessBackend& backend, int frames){
+	using Clock= std::chrono::steady_clock;
+	Result result;
+	SwanGui gui;
+	Bindings bindings;
+	scenario.m_build(gui, bindings);
+	gui.SetIdlePacing(SwanGui::PACING_WAIT_EVENTS);
+	for(int frame= 1; frame<= 60; frame++){
+		ScriptInput(backend, frame);
+		gui.Update();
+		gui.Draw();
+		backend.EndFrame();
+	}
+	for(int frame= 0; frame< frames; frame++){
+		auto t0= Clock::now();
+		gui.Update();
+		auto t1= Clock::now();
+		gui.Draw();
+		auto t2= Clock::now();
+		result.m_update.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+		result.m_draw.push_back(std::chrono::duration<double, std::micro>(t2 - t1).count());
+		result.m_updated+= gui.GetFrameStats().elements_updated;
+		result.m_rasterized+= gui.GetFrameStats().panels_rasterized;
+		gui.Pace();
+		if(backend.m_is_event_waiting) result.m_waiting++;
+		backend.EndFrame();
+	}
+	gui.SetIdlePacing(SwanGui::PACING_OFF);
+	gui.Pace();
+	result.m_updated/= frames;
+	result.m_rasterized/= frames;
+	result.m_waiting*= 100.0/frames;
+	return result;
+}
+
+//sliders, checkboxes and color pickers bound to SharedValues, as if another thread owned them
+static void AddSharedElements(Panel& panel, Bindings& bindings, int count){
+	for(int i= 0; i< count; i++){
+		std::string label= "Element " + std::to_string(i);
+		switch(i % 4){
+			case 0: panel.addElement(std::make_shared<Slider>(label, bindings.m_shared_ints.emplace_back(i % 100), 1, 0, 100)); break;
+			case 1: panel.addElement(std::make_shared<SliderF>(label, bindings.m_shared_floats.emplace_back(0.5f), 0.01f, 0.0f, 1.0f)); break;
+			case 2: panel.addElement(std::make_shared<CheckBox>(label, bindings.m_shared_bools.emplace_back(false))); break;
+			case 3: panel.addElement(std::make_shared<ColorPicker>(label, bindings.m_shared_colors.emplace_back(ui_special))); break;
+		}
+	}
+}
+
+//buttons, checkboxes and sliders only, the types a BucketPanel can hold, so both storage modes get the same rows
+static void AddSimpleElements(Panel& panel, Bindings& bindings, int count){
+	for(int i= 0; i< count; i++){
+		std::string label= "Element " + std::to_string(i);
+		switch(i % 3){
+			case 0: panel.addElement(std::make_shared<Button>(label, [](){})); break;
+			case 1: panel.addElement(std::make_shared<CheckBox>(label, bindings.m_bools.emplace_back(false))); break;
+			case 2: panel.addElement(std::make_shared<Slider>(label, bindings.m_ints.emplace_back(i % 100), 1, 0, 100)); break;
+		}
+	}
+}
+
+static void AddSimpleBuckets(BucketPanel& panel, Bindings& bindings, int count){
+	for(int i= 0; i< count; i++){
+		std::string label= "Element " + std::to_string(i);
+		switch(i % 3){
+			case 0: panel.addButton(label, [](){}); break;
+			case 1: panel.addCheckBox(label, bindings.m_bools.emplace_back(false)); break;
+			case 2: panel.addSlider(label, bindings.m_ints.emplace_back(i % 100), 1, 0, 100); break;
+		}
+	}
+}
+
+//warms the UI up with the input script, then parks the mouse and counts heap allocations over idle frames.
+//every element is marked dirty each idle frame so the whole draw path runs, not just the panel cache blit
+static size_t CountIdleAllocations(const Scenario& scenario, HeadlessBackend& backend){
+	SwanGui gui;
+	Bindings bindings;
+	scenario.m_build(gui, bindings);
+
+	for(int frame= 1; frame<= 120; frame++){
+		ScriptInput(backend, frame);
+		gui.Update();
+		gui.Draw();
+		backend.EndFrame();
+	}
+	//leave the text inputs in their editing state and one of them focused, so it is updated every frame.
+	//an idle frame with a focused field has to stay allocation free too
+	backend.MoveMouse((Vector2){5.0f, 5.0f});
+	for(auto& panel : gui.m_panels){
+		for(auto& element : panel->m_elements){
+			if(auto input= std::dynamic_pointer_cast<InputBox>(element)){
+				ui_focus.SetFocus(input.get());
+				input->m_get_input= true;
+			}
+			if(auto slider= std::dynamic_pointer_cast<Slider>(element)) slider->m_get_input= true;
+			if(auto slider= std::dynamic_pointer_cast<SliderF>(element)) slider->m_get_input= true;
+		}
+	}
+	for(int frame= 0; frame< 10; frame++){
+		gui.Update();
+		gui.Draw();
+		backend.EndFrame();
+	}
+
+	size_t allocations= g_allocations;
+	for(int frame= 0; frame< 120; frame++){
+		for(auto& panel : gui.m_panels){
+			for(auto& element : panel->m_elements) element->MarkDirty();
+		}
+		gui.Update();
+		gui.Draw();
+		backend.EndFrame();
+	}
+	return g_allocations - allocations;
+}
+
+//building should scale linearly with the element count, a resize re-flows without measuring again unless the width changed
+//and a move only carries the elements along
+static void LayoutBench(){
+	using Clock= std::chrono::steady_clock;
+	auto ms= [](Clock::time_point start){ return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+	printf("\n%-28s %10s %14s %14s %14s %14s\n", "layout", "build ms", "height ms", "width ms", "hide one ms", "move ms");
+	for(int count : {1000, 10000, 50000}){
+		Bindings bindings;
+		auto panel= std::make_shared<Panel>("Layout", (Vector2){1, 1}, (Vector2){20, 50}, true, 2, ui_backend->GetDefaultFont());
+		auto start= Clock::now();
+		AddMixedElements(*panel, bindings, count, 0);
+		double build= ms(start);
+
+		start= Clock::now();
+		panel->SetSize((Vector2){panel->m_size.x, panel->m_size.y + 20});
+		panel->Layout();
+		double height= ms(start);
+
+		start= Clock::now();
+		panel->SetSize((Vector2){panel->m_size.x + 20, panel->m_size.y});
+		panel->Layout();
+		double width= ms(start);
+
+		start= Clock::now();
+		panel->m_elements[count/2]->SetHidden(true);
+		panel->Layout();
+		double hide= ms(start);
+
+		start= Clock::now();
+		panel->SetPosition((Vector2){panel->m_position.x + 8, panel->m_position.y + 8});
+		panel->Layout();
+		double move= ms(start);
+
+		char name[32];
+		snprintf(name, sizeof(name), "%d elements", count);
+		printf("%-28s %10.2f %14.3f %14.3f %14.3f %14.3f\n", name, build, height, width, hide, move);
+	}
+}
+
+//a simulation thread ticks at 1 kHz: it applies the UI's change events, then writes every readout. the UI thread runs at 144 FPS
+//over a panel of sliders bound to the same values, half of them readouts and half parameters that the mouse keeps dragging
+static void BindingBench(HeadlessBackend& backend, double seconds){
+	using Clock= std::chrono::steady_clock;
+	printf("\n%-28s %12s %18s %18s %12s %12s\n", "bindings", "ticks/s", "tick p50/p99 us", "frame p50/p99 us", "batches/s", "changes/b");
+	for(int count : {1000, 10000}){
+		SwanGui gui;
+		std::deque<SharedValue<int>> readouts;
+		std::deque<SharedValue<int>> parameters;
+		auto panel= std::make_shared<Panel>("Bindings", (Vector2){1, 1}, (Vector2){20, 50});
+		panel->SetVirtualized(true);
+		for(int i= 0; i< count/2; i++){
+			panel->addElement(std::make_shared<Slider>("Readout " + std::to_string(i), readouts.emplace_back(0), 1, 0, 1000));
+			panel->addElement(std::make_shared<Slider>("Parameter " + std::to_string(i), parameters.emplace_back(50), 1, 0, 100));
+		}
+		gui.AddPanel(panel);
+
+		std::atomic<bool> is_running{true};
+		std::vector<double> tick_times;
+		tick_times.reserve((size_t)(seconds*1200));
+		long long batches= 0, changes= 0;
+		std::thread simulation([&](){
+			auto next= Clock::now();
+			for(int tick= 0; is_running.load(std::memory_order_relaxed); tick++){
+				auto t0= Clock::now();
+				size_t applied= ui_changes.Apply();
+				if(applied> 0){
+					batches++;
+					changes+= (long long)applied;
+				}
+				for(size_t i= 0; i< readouts.size(); i++) readouts[i].Store((int)((tick + i) % 1000));
+				tick_times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+				next+= std::chrono::milliseconds(1);
+				std::this_thread::sleep_until(next);
+			}
+		});
+
+		std::vector<double> frame_times;
+		auto start= Clock::now();
+		auto next= start;
+		auto frame_interval= std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0/144.0));
+		for(int frame= 0; Clock::now() - start< std::chrono::duration<double>(seconds); frame++){
+			//grabs the value of another parameter every 72 frames and drags it back and forth
+			GuiElement& parameter= *panel->m_elements[(frame/72 % 8)*2 + 1];
+			Vector2 grab= {parameter.m_position.x + parameter.m_size.x*0.75f, parameter.m_position.y + parameter.m_size.y*0.5f};
+			if(frame % 72== 0){
+				backend.MoveMouse(grab);
+				backend.PressButton(MOUSE_BUTTON_LEFT);
+			}
+			else backend.MoveMouse((Vector2){grab.x + ((frame % 72) % 20< 10 ? 2.0f : -2.0f)*((frame % 72) % 10), grab.y});
+			if(frame % 72== 71) backend.ReleaseButton(MOUSE_BUTTON_LEFT);
+			auto t0= Clock::now();
+			gui.Update();
+			gui.Draw();
+			frame_times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+			backend.EndFrame();
+			next+= frame_interval;
+			std::this_thread::sleep_until(next);
+		}
+		is_running= false;
+		simulation.join();
+		double elapsed= std::chrono::duration<double>(Clock::now() - start).count();
+		//drops whatever the UI published last, the values die with this scope
+		while(ui_changes.Apply()> 0){ gui.Update(); }
+		ui_focus.SetFocus(nullptr);
+
+		char name[32];
+		snprintf(name, sizeof(name), "%d values", count);
+		printf("%-28s %12.0f %8.1f/%9.1f %8.1f/%9.1f %12.1f %12.2f\n", name, tick_times.size()/elapsed, Percentile(tick_times, 0.50), Percentile(tick_times, 0.99),
+			Percentile(frame_times, 0.50), Percentile(frame_times, 0.99), batches/elapsed, batches ? (double)changes/batches : 0.0);
+	}
+}
+
+//producers log as fast as they can or at a fixed total rate, the UI thread runs frames paced to 144 FPS.
+//accepted lines made it into the queue, dropped ones found it full
+static void ConsoleBench(double seconds){
+	using Clock= std::chrono::steady_clock;
+	struct Case{ const char *m_name; int m_threads; double m_rate; const char *m_search; };
+	const Case cases[]= {
+		{"4 threads, 50k lines/s", 4, 50000, ""},
+		{"4 threads, flat out", 4, 0, ""},
+		{"4 threads, flat out, search", 4, 0, "served in 7"},
+	};
+
+	printf("\n%-28s %12s %12s %10s %18s %18s\n", "console ingest", "lines/s", "dropped/s", "fps", "frame p50/p99 us", "shown");
+	for(const Case& test : cases){
+		SwanGui gui;
+		auto panel= std::make_shared<Panel>("Console", (Vector2){1, 1}, (Vector2){30, 45});
+		auto console= std::make_shared<Console>(40);
+		panel->addElement(console);
+		gui.AddPanel(panel);
+		console->SetSearch(test.m_search);
+
+		std::atomic<bool> is_running{true};
+		std::vector<long long> accepted(test.m_threads, 0);
+		std::vector<std::thread> producers;
+		for(int t= 0; t< test.m_threads; t++){
+			producers.emplace_back([&, t](){
+				auto start= Clock::now();
+				double interval= (test.m_rate> 0) ? test.m_threads/test.m_rate : 0.0;
+				char line[96];
+				for(long long i= 0; is_running.load(std::memory_order_relaxed); i++){
+					snprintf(line, sizeof(line), "worker %d line %lld: request served in %d us", t, i, (int)(i % 997));
+					if(console->Log((i % 50== 0) ? LOG_WARNING : LOG_INFO, line)) accepted[t]++;
+					if(interval> 0 && i % 16== 15) std::this_thread::sleep_until(start + std::chrono::duration<double>((i + 1)*interval));
+				}
+			});
+		}
+
+		std::vector<double> frame_times;
+		auto start= Clock::now();
+		auto next= start;
+		auto frame_interval= std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0/144.0));
+		while(Clock::now() - start< std::chrono::duration<double>(seconds)){
+			auto t0= Clock::now();
+			gui.Update();
+			gui.Draw();
+			frame_times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+			next+= frame_interval;
+			std::this_thread::sleep_until(next);
+		}
+		double elapsed= std::chrono::duration<double>(Clock::now() - start).count();
+		is_running= false;
+		for(std::thread& producer : producers) producer.join();
+
+		long long total= 0;
+		for(long long count : accepted) total+= count;
+		printf("%-28s %12.0f %12.0f %10.1f %8.1f/%9.1f %18lld\n", test.m_name, total/elapsed, console->GetDropped()/elapsed, frame_times.size()/elapsed,
+			Percentile(frame_times, 0.50), Percentile(frame_times, 0.99), console->GetShownCount());
+	}
+}
+
+static double TableValue(int row, int column){
+	return (double)((unsigned int)(row + 1)*2654435761u % 1000003u)/(column + 1);
+}
+
+//cells are formatted on demand from the row and column, nothing is stored per row
+static std::shared_ptr<Table> MakeTable(int rows, int row_count, int columns){
+	auto table= std::make_shared<Table>(rows, row_count, [](int row, int column, char *buffer, int size){
+		if(column== 0) snprintf(buffer, size, "row %d", row);
+		else snprintf(buffer, size, "%.3f", TableValue(row, column));
+	});
+	table->m_sort_key= [](int row, int column){ return (column== 0) ? (double)row : TableValue(row, column); };
+	for(int i= 0; i< columns; i++) table->AddColumn("Column " + std::to_string(i), 90);
+	return table;
+}
+
+//a 1M x 20 table at 144 FPS: wheel scrolling, scroll bar jumps, then a column sort running while it keeps scrolling
+static void TableBench(HeadlessBackend& backend){
+	using Clock= std::chrono::steady_clock;
+	struct Case{ const char *m_name; int m_mode; };
+	enum{ MODE_WHEEL, MODE_JUMP, MODE_SORT, MODE_SORT_TEXT };
+	const Case cases[]= {
+		{"wheel scroll", MODE_WHEEL},
+		{"scroll bar jumps", MODE_JUMP},
+		{"sort by number", MODE_SORT},
+		{"sort by text", MODE_SORT_TEXT},
+	};
+
+	printf("\n%-28s %18s %10s %10s %12s\n", "table 1M x 20", "frame p50/p99 us", "max us", "cmds/f", "sort ms");
+	for(const Case& test : cases){
+		SwanGui gui;
+		auto panel= std::make_shared<Panel>("Table", (Vector2){1, 1}, (Vector2){60, 50});
+		auto table= MakeTable(45, 1000000, 20);
+		if(test.m_mode== MODE_SORT_TEXT) table->m_sort_key= nullptr;
+		panel->addElement(table);
+		gui.AddPanel(panel);
+		gui.Update();
+		gui.Draw();
+
+		Vector2 body= {table->m_position.x + 200, table->m_position.y + 200};
+		Vector2 bar= {table->m_position.x + table->m_size.x - 3, table->m_position.y + font_size + 2};
+		backend.MoveMouse(body);
+		if(test.m_mode== MODE_SORT || test.m_mode== MODE_SORT_TEXT){
+			backend.MoveMouse((Vector2){table->m_position.x + 200, table->m_position.y + font_size/2});
+			backend.PressButton(MOUSE_BUTTON_LEFT);
+			gui.Update();
+			gui.Draw();
+			backend.EndFrame();
+			backend.ReleaseButton(MOUSE_BUTTON_LEFT);
+			backend.MoveMouse(body);
+		}
+		if(test.m_mode== MODE_JUMP){
+			backend.MoveMouse(bar);
+			backend.PressButton(MOUSE_BUTTON_LEFT);
+		}
+
+		std::vector<double> frame_times;
+		double commands= 0;
+		double sort_ms= 0;
+		auto start= Clock::now();
+		auto next= start;
+		auto frame_interval= std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0/144.0));
+		for(int frame= 0; frame< 432 || table->IsSorting(); frame++){
+			if(test.m_mode== MODE_JUMP){
+				float y= bar.y + (table->m_rows*font_size - 4)*(0.5f + 0.5f*sinf(frame*0.37f));
+				backend.MoveMouse((Vector2){bar.x, y});
+			}
+			else{
+				backend.Scroll(-1.0f);
+			}
+			auto t0= Clock::now();
+			gui.Update();
+			gui.Draw();
+			frame_times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+			commands+= ui_frame_stats.draw_commands;
+			if(sort_ms== 0 && (test.m_mode== MODE_SORT || test.m_mode== MODE_SORT_TEXT) && !table->IsSorting()){
+				sort_ms= std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+			}
+			backend.EndFrame();
+			next+= frame_interval;
+			std::this_thread::sleep_until(next);
+		}
+		if(test.m_mode== MODE_JUMP) backend.ReleaseButton(MOUSE_BUTTON_LEFT);
+		gui.Update();
+		backend.EndFrame();
+
+		double max_time= *std::max_element(frame_times.begin(), frame_times.end());
+		if(sort_ms> 0) printf("%-28s %8.1f/%9.1f %10.1f %10.0f %12.1f\n", test.m_name, Percentile(frame_times, 0.50), Percentile(frame_times, 0.99), max_time, commands/frame_times.size(), sort_ms);
+		else printf("%-28s %8.1f/%9.1f %10.1f %10.0f %12s\n", test.m_name, Percentile(frame_times, 0.50), Percentile(frame_times, 0.99), max_time, commands/frame_times.size(), "-");
+	}
+}
+
+//a noisy sine per series, the same block of samples is pushed over and over
+static std::vector<float> PlotSamples(int series, size_t count){
+	std::vector<float> samples(count);
+	unsigned int seed= 12345u + series;
+	for(size_t i= 0; i< count; i++){
+		seed= seed*1664525u + 1013904223u;
+		samples[i]= sinf(i*0.001f*(series + 1)) + (seed >> 8)*(0.2f/16777216.0f) + series;
+	}
+	return samples;
+}
+
+static std::shared_ptr<Plot> MakePlot(int series, size_t points){
+	auto plot= std::make_shared<Plot>(30, points);
+	std::vector<float> samples= PlotSamples(0, points);
+	for(int i= 0; i< series; i++){
+		plot->AddSeries("series " + std::to_string(i), (Color){(unsigned char)(60 + i*12), (unsigned char)(200 - i*8), 220, 255});
+		for(float& sample : samples) sample+= 1.0f;
+		plot->Push(i, samples.data(), samples.size());
+	}
+	return plot;
+}
+
+//16 series with 1M points each at 144 FPS while new samples stream in, and while the window is zoomed every frame,
+//which makes every series reduce its whole window again
+static void PlotBench(HeadlessBackend& backend){
+	using Clock= std::chrono::steady_clock;
+	struct Case{ const char *m_name; size_t m_per_frame; bool m_is_zooming; };
+	const Case cases[]= {
+		{"+1k samples/frame", 1000, false},
+		{"+10k samples/frame", 10000, false},
+		{"+1k, zoom every frame", 1000, true},
+	};
+
+	std::vector<std::vector<float>> blocks;
+	for(int i= 0; i< 16; i++) blocks.push_back(PlotSamples(i, 10000));
+
+	printf("\n%-28s %18s %10s %10s %12s %12s\n", "plot 16 x 1M", "frame p50/p99 us", "max us", "cmds/f", "points/f", "samples/s");
+	for(const Case& test : cases){
+		SwanGui gui;
+		auto panel= std::make_shared<Panel>("Plot", (Vector2){1, 1}, (Vector2){40, 30});
+		auto plot= MakePlot(16, 1 << 20);
+		panel->addElement(plot);
+		gui.AddPanel(panel);
+		gui.Update();
+		gui.Draw();
+		backend.EndFrame();
+		backend.MoveMouse((Vector2){plot->m_position.x + 100, plot->m_position.y + 100});
+
+		std::vector<double> frame_times;
+		double commands= 0;
+		long long points= backend.m_line_points;
+		auto start= Clock::now();
+		auto next= start;
+		auto frame_interval= std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0/144.0));
+		for(int frame= 0; frame< 432; frame++){
+			if(test.m_is_zooming) backend.Scroll((frame % 2) ? 1.0f : -1.0f);
+			auto t0= Clock::now();
+			for(int i= 0; i< 16; i++){
+				size_t offset= (frame*test.m_per_frame) % (blocks[i].size() - test.m_per_frame + 1);
+				plot->Push(i, blocks[i].data() + offset, test.m_per_frame);
+			}
+			gui.Update();
+			gui.Draw();
+			frame_times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+			commands+= ui_frame_stats.draw_commands;
+			backend.EndFrame();
+			next+= frame_interval;
+			std::this_thread::sleep_until(next);
+		}
+		double elapsed= std::chrono::duration<double>(Clock::now() - start).count();
+		double max_time= *std::max_element(frame_times.begin(), frame_times.end());
+		printf("%-28s %8.1f/%9.1f %10.1f %10.0f %12.0f %12.0f\n", test.m_name, Percentile(frame_times, 0.50), Percentile(frame_times, 0.99), max_time,
+			commands/frame_times.size(), (double)(backend.m_line_points - points)/frame_times.size(), 16.0*test.m_per_frame*frame_times.size()/elapsed);
+	}
+}
+
+//a panel of thumbnails whose images take m_decode_time each to read, loaded in the background or before the first frame
+static void AssetBench(HeadlessBackend& backend){
+	using Clock= std::chrono::steady_clock;
+	struct Case{ const char *m_name; int m_count; bool m_is_async; };
+	const Case cases[]= {
+		{"10 images", 10, true},
+		{"100 images", 100, true},
+		{"1000 images", 1000, true},
+		{"1000 images, synchronous", 1000, false},
+	};
+
+	backend.m_decode_time= 0.002;
+	printf("\n%-28s %16s %16s %18s\n", "assets (2 ms decode)", "first frame ms", "all loaded ms", "frame p50/p99 us");
+	for(const Case& test : cases){
+		ui_load_async= test.m_is_async;
+		auto start= Clock::now();
+		SwanGui gui;
+		auto panel= std::make_shared<Panel>("Images", (Vector2){1, 1}, (Vector2){20, 50});
+		panel->SetVirtualized(true);
+		for(int i= 0; i< test.m_count; i++){
+			std::string path= "bench/" + std::to_string(test.m_count) + (test.m_is_async ? "/a" : "/s") + std::to_string(i) + ".png";
+			panel->addElement(std::make_shared<Thumbnail>("Image " + std::to_string(i), path, [](){}, "Open"));
+		}
+		gui.AddPanel(panel);
+		gui.Update();
+		gui.Draw();
+		double first_frame= std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		std::vector<double> frame_times;
+		auto next= Clock::now();
+		auto frame_interval= std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0/144.0));
+		while(AssetLoader::Get().GetPending()> 0){
+			auto t0= Clock::now();
+			gui.Update();
+			gui.Draw();
+			frame_times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+			next+= frame_interval;
+			std::this_thread::sleep_until(next);
+		}
+		double loaded= std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		printf("%-28s %16.1f %16.1f %8.1f/%9.1f\n", test.m_name, first_frame, loaded, Percentile(frame_times, 0.50), Percentile(frame_times, 0.99));
+	}
+	ui_load_async= true;
+	backend.m_decode_time= 0.0;
+}
+
+int main(int argc, char **argv){
+	bool check_allocs= (argc> 1 && strcmp(argv[1], "--check-allocs")== 0);
+	int frames= (argc> 1 && !check_allocs) ? std::max(1, atoi(argv[1])) : 300;
+
+	//has to be set before any panel is created, panels pick their default font from it
+	HeadlessBackend backend;
+	ui_backend= &backend;
+
+	std::vector<Scenario> scenarios= {
+		{"10 elements", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<Panel>("Panel", (Vector2){1, 1}, (Vector2){12, 20});
+			AddMixedElements(*panel, bindings, 10, 0);
+			gui.AddPanel(panel);
+		}},
+		{"1k elements, 10 panels", [](SwanGui& gui, Bindings& bindings){
+			for(int i= 0; i< 10; i++){
+				auto panel= std::make_shared<Panel>("Panel " + std::to_string(i), (Vector2){(float)(i*9), 0}, (Vector2){9, 54});
+				AddMixedElements(*panel, bindings, 100, i*100);
+				gui.AddPanel(panel);
+			}
+		}},
+		{"100k elements, virtualized", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<Panel>("Rows", (Vector2){1, 1}, (Vector2){20, 50});
+			panel->SetVirtualized(true);
+			AddMixedElements(*panel, bindings, 100000, 0);
+			gui.AddPanel(panel);
+		}},
+		{"100k elements, arena", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<Panel>("Rows", (Vector2){1, 1}, (Vector2){20, 50});
+			panel->SetVirtualized(true);
+			EmplaceMixedElements(*panel, bindings, 100000, 0);
+			gui.AddPanel(panel);
+		}},
+		{"10k rows, virtual dispatch", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<Panel>("Rows", (Vector2){1, 1}, (Vector2){20, 50});
+			AddSimpleElements(*panel, bindings, 10000);
+			gui.AddPanel(panel);
+		}},
+		{"10k rows, virtualized", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<Panel>("Rows", (Vector2){1, 1}, (Vector2){20, 50});
+			panel->SetVirtualized(true);
+			AddSimpleElements(*panel, bindings, 10000);
+			gui.AddPanel(panel);
+		}},
+		{"10k rows, type buckets", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<BucketPanel>("Rows", (Vector2){1, 1}, (Vector2){20, 50});
+			AddSimpleBuckets(*panel, bindings, 10000);
+			gui.AddPanel(panel);
+		}},
+		{"100k rows, type buckets", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<BucketPanel>("Rows", (Vector2){1, 1}, (Vector2){20, 50});
+			AddSimpleBuckets(*panel, bindings, 100000);
+			gui.AddPanel(panel);
+		}},
+		{"1k shared bindings", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<Panel>("Shared", (Vector2){1, 1}, (Vector2){20, 50});
+			AddSharedElements(*panel, bindings, 1000);
+			gui.AddPanel(panel);
+		}},
+		{"console, 16k lines", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<Panel>("Console", (Vector2){1, 1}, (Vector2){30, 45});
+			auto console= std::make_shared<Console>(40, 16384);
+			for(int i= 0; i< 16384; i++) console->Logf((i % 50== 0) ? LOG_WARNING : LOG_INFO, "line %d: request served in %d us", i, i % 997);
+			panel->addElement(console);
+			gui.AddPanel(panel);
+		}},
+		{"table, 1M x 20", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<Panel>("Table", (Vector2){1, 1}, (Vector2){40, 45});
+			panel->addElement(MakeTable(40, 1000000, 20));
+			gui.AddPanel(panel);
+		}},
+		{"plot, 16 x 1M", [](SwanGui& gui, Bindings& bindings){
+			auto panel= std::make_shared<Panel>("Plot", (Vector2){1, 1}, (Vector2){40, 30});
+			panel->addElement(MakePlot(16, 1 << 20));
+			gui.AddPanel(panel);
+		}},
+		{"500 panels x 8 elements", [](SwanGui& gui, Bindings& bindings){
+			for(int i= 0; i< 500; i++){
+				auto panel= std::make_shared<Panel>("Panel " + std::to_string(i), (Vector2){(float)((i % 25)*4), (float)((i / 25)*3)}, (Vector2){4, 10});
+				AddMixedElements(*panel, bindings, 8, i*8);
+				gui.AddPanel(panel);
+			}
+		}},
+	};
+
+	if(check_allocs){
+		int failed= 0;
+		for(const Scenario& scenario : scenarios){
+			size_t allocations= CountIdleAllocations(scenario, backend);
+			printf("%-28s %8zu allocations over 120 idle frames\n", scenario.m_name, allocations);
+			if(allocations> 0) failed++;
+		}
+		return failed ? 1 : 0;
+	}
+
+	printf("%d frames per scenario\n\n", frames);
+	printf("%-28s %10s %12s %24s %24s %10s %10s %10s %10s %10s\n", "scenario", "build ms", "build allocs", "update p50/p95/p99 us", "draw p50/p95/p99 us", "allocs/f", "cmds/f", "batches/f", "raster/f", "updated/f");
+	for(const Scenario& scenario : scenarios){
+		Result r= Run(scenario, backend, frames);
+		printf("%-28s %10.1f %12.0f %7.1f/%7.1f/%7.1f %7.1f/%7.1f/%7.1f %10.1f %10.1f %10.1f %10.2f %10.1f\n", scenario.m_name, r.m_build_ms, r.m_build_allocations,
+			Percentile(r.m_update, 0.50), Percentile(r.m_update, 0.95), Percentile(r.m_update, 0.99),
+			Percentile(r.m_draw, 0.50), Percentile(r.m_draw, 0.95), Percentile(r.m_draw, 0.99),
+			r.m_allocations, r.m_commands, r.m_batches, r.m_rasterized, r.m_updated);
+	}
+
+	printf("\n%-28s %16s %16s %10s %10s %10s\n", "idle", "update p50 us", "draw p50 us", "raster/f", "updated/f", "waiting %");
+	for(const Scenario& scenario : scenarios){
+		Result r= RunIdle(scenario, backend, frames);
+		printf("%-28s %16.1f %16.1f %10.2f %10.1f %10.0f\n", scenario.m_name, Percentile(r.m_update, 0.50), Percentile(r.m_draw, 0.50), r.m_rasterized, r.m_updated, r.m_waiting);
+	}
+	LayoutBench();
+	BindingBench(backend, 1.0);
+	ConsoleBench(1.0);
+	TableBench(backend);
+	PlotBench(backend);
+	AssetBench(backend);
+	return 0;
+}
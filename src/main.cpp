@@ -1,4 +1,5 @@
 #include "swangui.h"
+#include <thread>
 
 void DrawDemo3DScene(Camera3D& camera) {
     for (int x = -2; x <= 2; x++) {
@@ -30,17 +31,8 @@ int main()
 	SetTargetFPS(144);
 
 	Font custom_font= LoadFontEx("resource/source-sans-pro.bold.ttf", 14, 0, 0);
-	Texture2D fish= LoadTexture("resource/fish.png");
-	Texture2D logo= LoadTexture("resource/swan.png");
-
-	Texture2D c1= LoadTexture("resource/1.png");
-	Texture2D c2= LoadTexture("resource/2.png");
-	Texture2D c3= LoadTexture("resource/3.png");
-	Texture2D c4= LoadTexture("resource/4.png");
-	Texture2D c5= LoadTexture("resource/5.png");
-	Texture2D c6= LoadTexture("resource/6.png");
-	Texture2D c7= LoadTexture("resource/7.png");
-	Texture2D c8= LoadTexture("resource/8.png");
+	std::string fish= "resource/fish.png";
+	std::string logo= "resource/swan.png";
 
 	Vector2 panelPos1= {0, 0};
 	Vector2 panelPos2= {10, 0};
@@ -94,57 +86,61 @@ int main()
 	bool no= false;
 	int worldSize= 32000;
 	int entityCount= 128;
-	panel1->addElement(std::make_shared<Button>("Apply Gravity", [](){}, false));
-	panel1->addElement(std::make_shared<Slider>("Force", force, 1, -100, 100));
-	panel1->addElement(std::make_shared<CheckBox>("Speed Limit", yes));
-	panel1->addElement(std::make_shared<CheckBox>("World Border", no));
-	panel1->addElement(std::make_shared<Slider>("World Size", worldSize, 10));
-	panel1->addElement(std::make_shared<Slider>("Entity Count", entityCount, 1));
+	panel1->emplaceElement<Button>("Apply Gravity", [](){}, false);
+	panel1->emplaceElement<Slider>("Force", force, 1, -100, 100);
+	panel1->emplaceElement<CheckBox>("Speed Limit", yes);
+	panel1->emplaceElement<CheckBox>("World Border", no);
+	panel1->emplaceElement<Slider>("World Size", worldSize, 10);
+	panel1->emplaceElement<Slider>("Entity Count", entityCount, 1);
 	int colorCount= 3;
-	panel1->addElement(std::make_shared<Button>("Invert Colors", [](){}, false));
-	panel1->addElement(std::make_shared<Slider>("Color Count", colorCount, 1));
-	panel1->addElement(std::make_shared<CheckBox>("Invert", no));
-	panel1->addElement(std::make_shared<Button>("Add Color", [](){}, false));
-	panel1->addElement(std::make_shared<Thumbnail>("logo.png", logo, [](){}, "Rotate 90'"));
+	panel1->emplaceElement<Button>("Invert Colors", [](){}, false);
+	panel1->emplaceElement<Slider>("Color Count", colorCount, 1);
+	panel1->emplaceElement<CheckBox>("Invert", no);
+	panel1->emplaceElement<Button>("Add Color", [](){}, false);
+	panel1->emplaceElement<Thumbnail>("logo.png", logo, [](){}, "Rotate 90'");
 	int attachments= 7;
-	panel1->addElement(std::make_shared<Button>("Attach Selected", [](){}, false));
-	panel1->addElement(std::make_shared<Slider>("Attachments", attachments, 1));
-	panel1->addElement(std::make_shared<Slider>("Attach Limit", attachments, 1));
-	panel1->addElement(std::make_shared<CheckBox>("Attachments", yes));
-	panel1->addElement(std::make_shared<Button>("Deattach", [](){}, false));
+	panel1->emplaceElement<Button>("Attach Selected", [](){}, false);
+	panel1->emplaceElement<Slider>("Attachments", attachments, 1);
+	panel1->emplaceElement<Slider>("Attach Limit", attachments, 1);
+	panel1->emplaceElement<CheckBox>("Attachments", yes);
+	panel1->emplaceElement<Button>("Deattach", [](){}, false);
 	int selection= 23;
-	panel1->addElement(std::make_shared<Button>("Merge Meshes", [](){}, false));
-	panel1->addElement(std::make_shared<Slider>("Selected", selection, 1));
-	panel1->addElement(std::make_shared<CheckBox>("Auto Merge", no));
-	panel1->addElement(std::make_shared<CheckBox>("Clipping", yes));
-	panel1->addElement(std::make_shared<CheckBox>("Bounding Box", yes));
+	panel1->emplaceElement<Button>("Merge Meshes", [](){}, false);
+	panel1->emplaceElement<Slider>("Selected", selection, 1);
+	panel1->emplaceElement<CheckBox>("Auto Merge", no);
+	panel1->emplaceElement<CheckBox>("Clipping", yes);
+	panel1->emplaceElement<CheckBox>("Bounding Box", yes);
 	int cubeCount= 19;
-	panel1->addElement(std::make_shared<Button>("Triangulate", [](){}, false));
-	panel1->addElement(std::make_shared<Button>("Reverse", [](){}, false));
-	panel1->addElement(std::make_shared<Button>("Subdivide", [](){}, false));
-	panel1->addElement(std::make_shared<Button>("Toggle Wires", [](){}, false));
-	panel1->addElement(std::make_shared<Button>("Add Cube", [](){}, false));
-	panel1->addElement(std::make_shared<Slider>("Cube Count", cubeCount, 1));
-	panel1->addElement(std::make_shared<Button>("Lock Cursor", [](){}, false));
-	panel1->addElement(std::make_shared<Button>("Add Break Point", [](){}, false));
-	panel1->addElement(std::make_shared<CheckBox>("Until Failure", yes));
-	panel1->addElement(std::make_shared<Button>("Restore Scene", [](){}, false));
-	panel1->addElement(std::make_shared<Button>("SAVE AND EXIT", [](){}, true));
+	panel1->emplaceElement<Button>("Triangulate", [](){}, false);
+	panel1->emplaceElement<Button>("Reverse", [](){}, false);
+	panel1->emplaceElement<Button>("Subdivide", [](){}, false);
+	panel1->emplaceElement<Button>("Toggle Wires", [](){}, false);
+	panel1->emplaceElement<Button>("Add Cube", [](){}, false);
+	panel1->emplaceElement<Slider>("Cube Count", cubeCount, 1);
+	panel1->emplaceElement<Button>("Lock Cursor", [](){}, false);
+	panel1->emplaceElement<Button>("Add Break Point", [](){}, false);
+	panel1->emplaceElement<CheckBox>("Until Failure", yes);
+	panel1->emplaceElement<Button>("Restore Scene", [](){}, false);
+	panel1->emplaceElement<Button>("SAVE AND EXIT", [](){}, true);
 	std::string testaaa= "hello world";
-	panel1->addElement(std::make_shared<InputBox>("test", testaaa, 12));
+	panel1->emplaceElement<InputBox>("test", testaaa, 12);
+	auto advanced= panel1->emplaceElement<Group>("ADVANCED");
+	advanced->addElement(std::make_shared<CheckBox>("Wireframe", no));
+	advanced->addElement(std::make_shared<Slider>("Max Depth", attachments, 1));
+	advanced->SetMinimized(true);
 
 	int colorCount2= 8;
 	panel2->addElement(std::make_shared<Comment>("Colors"));
 	panel2->addElement(std::make_shared<Button>("Add Color", [](){}, false));
 	panel2->addElement(std::make_shared<Button>("Remove Color", [](){}, false));
-	panel2->addElement(std::make_shared<Thumbnail>("Red", c1, [](){}, "Select"));
-	panel2->addElement(std::make_shared<Thumbnail>("Orange", c2, [](){}, "Select"));
-	panel2->addElement(std::make_shared<Thumbnail>("Yellow", c3, [](){}, "Select"));
-	panel2->addElement(std::make_shared<Thumbnail>("Green", c4, [](){}, "Select"));
-	panel2->addElement(std::make_shared<Thumbnail>("Cyan", c5, [](){}, "Select"));
-	panel2->addElement(std::make_shared<Thumbnail>("Blue", c6, [](){}, "Select"));
-	panel2->addElement(std::make_shared<Thumbnail>("Purple", c7, [](){}, "Select"));
-	panel2->addElement(std::make_shared<Thumbnail>("Pink", c8, [](){}, "Select"));
+	panel2->addElement(std::make_shared<Thumbnail>("Red", "resource/1.png", [](){}, "Select"));
+	panel2->addElement(std::make_shared<Thumbnail>("Orange", "resource/2.png", [](){}, "Select"));
+	panel2->addElement(std::make_shared<Thumbnail>("Yellow", "resource/3.png", [](){}, "Select"));
+	panel2->addElement(std::make_shared<Thumbnail>("Green", "resource/4.png", [](){}, "Select"));
+	panel2->addElement(std::make_shared<Thumbnail>("Cyan", "resource/5.png", [](){}, "Select"));
+	panel2->addElement(std::make_shared<Thumbnail>("Blue", "resource/6.png", [](){}, "Select"));
+	panel2->addElement(std::make_shared<Thumbnail>("Purple", "resource/7.png", [](){}, "Select"));
+	panel2->addElement(std::make_shared<Thumbnail>("Pink", "resource/8.png", [](){}, "Select"));
 	panel2->addElement(std::make_shared<Button>("Add List", [](){}, false));
 	panel2->addElement(std::make_shared<Button>("SAVE COLORS", [](){}, true));
 	panel2->addElement(std::make_shared<Button>("Sort By Red", [](){}, false));
@@ -174,17 +170,60 @@ int main()
 	camera.up= (Vector3){0.0f, 1.0f, 0.0f};
 	camera.fovy= 65.0f;
 	panel5->addElement(std::make_shared<Comment>("Interactive 3D Camera View"));
-	panel5->addElement(std::make_shared<CameraView3D>(camera, DrawDemo3DScene, ui_panel_body));
+	auto cameraView= std::make_shared<CameraView3D>(camera, DrawDemo3DScene, ui_panel_body);
+	cameraView->SetRenderPolicy(CameraView::RENDER_ON_CAMERA_CHANGE);
+	panel5->addElement(cameraView);
 
 	panel6->addElement(std::make_shared<Comment>("Another Interactive 3D Camera View"));
 	panel6->addElement(std::make_shared<CameraView3D>(camera, drawSceneFunction, ui_panel_body));
 
-	panel1->addElement(std::make_shared<ColorPicker>("Accent Color", ui_background));
-	panel1->addElement(std::make_shared<ColorPicker>("Accent Color", ui_special));
-	panel1->addElement(std::make_shared<ColorPicker>("Panel Body", ui_panel_body));
-	panel1->addElement(std::make_shared<ColorPicker>("Panel Header", ui_panel_header));
-	panel1->addElement(std::make_shared<ColorPicker>("Element Body", ui_element_body));
-	panel1->addElement(std::make_shared<ColorPicker>("Text Light", ui_text_light));
+	panel1->emplaceElement<ColorPicker>("Accent Color", ui_background);
+	panel1->emplaceElement<ColorPicker>("Accent Color", ui_special);
+	panel1->emplaceElement<ColorPicker>("Panel Body", ui_panel_body);
+	panel1->emplaceElement<ColorPicker>("Panel Header", ui_panel_header);
+	panel1->emplaceElement<ColorPicker>("Element Body", ui_element_body);
+	panel1->emplaceElement<ColorPicker>("Text Light", ui_text_light);
+
+	int minLevel= LOG_ALL;
+	std::string search;
+	auto panel10= std::make_shared<Panel>("CONSOLE", (Vector2){52, 0}, (Vector2){24, 26}, custom_font);
+	auto console= std::make_shared<Console>(20);
+	console->BindFilter(&minLevel, &search);
+	panel10->addElement(std::make_shared<Slider>("Min Level", minLevel, 1, LOG_ALL, LOG_ERROR));
+	panel10->addElement(std::make_shared<InputBox>("Search", search, 24));
+	panel10->addElement(console);
+	//owned by the worker, the slider shows snapshots of it and its edits are applied by the worker
+	SharedValue<int> workerTick(0);
+	panel10->addElement(std::make_shared<Slider>("Worker Tick", workerTick, 1));
+	panel1->emplaceElement<Button>("Log Something", [console](){ console->Log(LOG_INFO, "button pressed"); }, false);
+
+	//a worker that logs on its own, Log() can be called from any thread
+	std::atomic<bool> isRunning= true;
+	std::thread worker([&](){
+		while(isRunning){
+			ui_changes.Apply();
+			int i= workerTick.Load() + 1;
+			workerTick.Store(i);
+			console->Logf((i % 10== 9) ? LOG_WARNING : LOG_INFO, "worker tick %d", i);
+			std::this_thread::sleep_for(std::chrono::milliseconds(250));
+		}
+	});
+
+	//a million rows computed on demand, only the visible cells are ever asked for
+	auto panel11= std::make_shared<Panel>("TABLE", (Vector2){52, 26}, (Vector2){24, 26}, custom_font);
+	auto sample= [](int row, int column){ return (double)((unsigned int)(row + 1)*2654435761u % 100000u)/(column + 1); };
+	auto plot= std::make_shared<Plot>(8, 4096);
+	int frameSeries= plot->AddSeries("frame ms", ui_special);
+	int batchSeries= plot->AddSeries("draw batches", ui_log_warning);
+	panel11->addElement(plot);
+	auto table= std::make_shared<Table>(14, 1000000, [sample](int row, int column, char *buffer, int size){
+		if(column== 0) snprintf(buffer, size, "%d", row);
+		else snprintf(buffer, size, "%.2f", sample(row, column));
+	});
+	table->m_sort_key= [sample](int row, int column){ return (column== 0) ? (double)row : sample(row, column); };
+	table->AddColumn("Row", 70);
+	for(int i= 1; i< 20; i++) table->AddColumn("Value " + std::to_string(i), 80);
+	panel11->addElement(table);
 
 	swanGui.AddPanel(panel1);
 	swanGui.AddPanel(panel2);
@@ -192,8 +231,14 @@ int main()
 	swanGui.AddPanel(panel4);
 	swanGui.AddPanel(panel5);
 	swanGui.AddPanel(panel6);
+	swanGui.AddPanel(panel10);
+	swanGui.AddPanel(panel11);
 	// swanGui.AddPanel(panel7);
 
+	//slow down while nothing animates and there is no input. the worker's log lines and ticks change from another thread,
+	//which can't wake an EndDrawing() blocked with PACING_WAIT_EVENTS
+	swanGui.SetIdlePacing(SwanGui::PACING_THROTTLE);
+
 	while(!WindowShouldClose())
 	{
 		swanGui.Update();
@@ -202,8 +247,16 @@ int main()
 			ClearBackground( ui_background );
 			swanGui.Draw();
 
+			const FrameStats& stats= swanGui.GetFrameStats();
+			plot->Push(frameSeries, GetFrameTime()*1000.0f);
+			plot->Push(batchSeries, (float)stats.draw_batches);
+			DrawText(TextFormat("panels redrawn: %i  cached: %i  draw batches: %i", stats.panels_rasterized, stats.panels_blitted, stats.draw_batches), 10, GetScreenHeight() -20, 10, ui_panel_header);
+
+			swanGui.Pace();
 		EndDrawing();
 	}
+	isRunning= false;
+	worker.join();
 	CloseWindow();
 	return 0;
 }
\ No newline at end of file
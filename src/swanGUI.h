@@ -35,12 +35,31 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <new>
 #include <functional>
 #include <sstream>
 #include <iostream>
 #include "raylib.h"
+#include "rlgl.h"
 #include <cfloat>
+#include <climits>
+#include <cmath>
+#include <algorithm>
 #include <iomanip>
+#include <unordered_map>
+#include <chrono>
+#include <charconv>
+#include <string_view>
+#include <cstdio>
+#include <cstring>
+#include <cstdarg>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 inline Color ui_background=	{221, 221, 221, 255};
 inline Color ui_panel_body=	   {19, 19, 19, 255};
@@ -58,1236 +77,5740 @@ inline Color ui_text_highl= {255, 255, 255, 255};
 inline Color ui_special=	{144, 159, 175, 255};
 inline Color ui_special_h=	{165, 182, 201, 255};
 
+inline Color ui_log_warning=	{230, 184, 92, 255};
+inline Color ui_log_error=	{224, 96, 86, 255};
+
 inline const int font_size= 14;
 inline const int element_padding= 3;
 inline const float thumnnail_size= 32.0f;
 inline const int grid_size= 20;
+inline float ui_scroll_smoothing= 0.35f;	//part of the remaining scroll distance covered per frame, 1 jumps there at once
+
+//animations whose frames fit in this many bytes are uploaded once into an atlas, 0 always streams
+inline size_t ui_atlas_memory_limit= 16*1024*1024;
+inline int ui_atlas_max_size= 4096;		//largest atlas side, keep it within the GPU texture limit
+
+//images and gifs are decoded on loader threads, the main thread uploads them for at most this many seconds per frame
+inline float ui_upload_budget= 0.002f;
+inline int ui_loader_threads= 0;		//0 picks from the number of cores
+inline bool ui_load_async= true;		//false decodes and uploads on the thread that asks, before the call returns
+
+struct FrameStats{
+	int panels_rasterized= 0;	//panels whose cache was redrawn this frame (or drawn without a cache)
+	int panels_blitted= 0;		//panels that only copied their cached texture to the screen
+	int panels_culled= 0;		//top level panels skipped because they are off screen
+	int elements_updated= 0;	//elements whose Update() ran, only the ones input was routed to or that asked for it
+	int draw_commands= 0;		//commands recorded into draw lists
+	int draw_batches= 0;		//texture batches those commands were submitted in
+};
 
-class Panel;
-class Button;
-class CheckBox;
-class Slider;
-class Comment;
-class Thumbnail;
-class ThumnailGif;
-class Billboard;
-class BillboardGif;
-class CameraView3D;
-class CameraView3DFill;
-class ColorPicker;
+inline FrameStats ui_frame_stats;
 
-std::string to_string(int value){
-	std::ostringstream stream;
-	stream << value;
-	return stream.str();
-}
+//bumped whenever an element or panel rectangle changes, the hit index is rebuilt lazily when it differs
+inline unsigned int ui_layout_version= 0;
 
-inline std::string b2s(bool value){
-	std::string is= value ? "Enabled" : "Disabled";
-	return is;
-}
+class GuiElement;
 
-class GuiElement {//_______________________________________________________________________________ GUI ELEMENTS ____________________________________________________________________________//
-public:
-	Vector2 m_position= {0, 0};
-	Vector2 m_size= {0, 0};
-	std::string m_text;
-	Font m_font;
-	bool m_is_visible= true;
+struct HoverState{
+	unsigned int m_generation= 0;	//hit index build this state belongs to, elements carry the build they were indexed in
+	Vector2 m_mouse= {0, 0};
+	GuiElement *m_panel= nullptr;
+	GuiElement *m_element= nullptr;
+};
 
-	virtual void Update()= 0;
-	virtual void Draw()= 0;
+inline HoverState ui_hover;
 
-	void SetPosition(Vector2 pos){ m_position= pos; }
-	void SetSize(Vector2 size){ m_size= size; }
-	void SetFont(Font font){m_font= font;};
+inline const float text_spacing= 2.0f;
+inline const float text_line_spacing= 2.0f;
 
-	bool IsMouseOver() const;
-	bool IsMouseOverEx(Vector2 position, Vector2 size) const;
+//a string laid out once with the real metrics of its font, glyph rectangles are relative to the text origin
+struct TextRun{
+	struct Glyph{
+		Rectangle m_source;
+		Rectangle m_dest;
+	};
+	Vector2 m_size= {0, 0};
+	std::vector<Glyph> m_glyphs;
 };
 
-inline bool GuiElement::IsMouseOver() const{
-	Vector2 mousePos= GetMousePosition();
-	return (mousePos.x >= m_position.x && mousePos.x <= m_position.x + m_size.x && mousePos.y >= m_position.y && mousePos.y <= m_position.y + m_size.y);
-}
+//runs stay valid until the end of the frame, the cache is only trimmed in EndFrame() so a caller can hold several of them
+class TextCache{
+public:
+	unsigned int m_generation= 1;	//bumped on Clear(), CachedText uses it to drop stale pointers
+	size_t m_max_entries= 8192;		//checked once per frame, a single frame may shape more than this
 
-inline bool GuiElement::IsMouseOverEx(Vector2 position, Vector2 size) const{
-	Vector2 mousePos= GetMousePosition();
-	return (mousePos.x >= position.x && mousePos.x <= position.x + size.x && mousePos.y >= position.y && mousePos.y <= position.y + size.y);
-}
+	static TextCache& Get(){
+		static TextCache cache;
+		return cache;
+	}
 
-class Button: public GuiElement{
-public:
-	std::function<void()> m_call_back_function;
-	bool m_is_special;
+	const TextRun& Shape(const Font& font, const std::string& text, float size, float spacing){
+		Key key= {font.texture.id, font.baseSize, size, spacing, text};
+		auto it= m_runs.find(key);
+		if(it!= m_runs.end()) return it->second;
 
-	Button(const std::string text, std::function<void()> call_back_function, bool is_special){
-		m_text= text;
-		m_call_back_function= call_back_function;
-		m_is_special= is_special;
+		//inserting into an unordered_map keeps references to the other runs valid
+		TextRun& run= m_runs[key];
+		Layout(font, text.c_str(), size, spacing, run);
+		return run;
 	}
 
-	Button(const std::string text, std::function<void()> call_back_function){
-		m_text= text;
-		m_call_back_function= call_back_function;
-		m_is_special= false;
+	void Clear(){
+		m_runs.clear();
+		m_generation++;
 	}
 
-	void Update() override{
-		if(IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			if(m_call_back_function){
-				m_call_back_function();
+	//called by SwanGui::Update() before anything is shaped for the new frame
+	void EndFrame(){
+		if(m_runs.size()> m_max_entries) Clear();
+	}
+
+	//same placement as DrawTextEx(), so drawing a run matches what raylib would have drawn
+	static void Layout(const Font& font, const char *text, float size, float spacing, TextRun& run){
+		run.m_glyphs.clear();
+		run.m_size= (Vector2){0, size};
+		if(font.glyphs== nullptr || font.recs== nullptr || font.baseSize== 0) return;
+
+		float scale= size/font.baseSize;
+		float pad= (float)font.glyphPadding;
+		float offset_x= 0.0f;
+		float offset_y= 0.0f;
+		for(int i= 0; text[i]!= '\0';){
+			int byte_count= 0;
+			int codepoint= GetCodepointNext(&text[i], &byte_count);
+			int index= GetGlyphIndex(font, codepoint);
+			i+= byte_count;
+
+			if(codepoint== '\n'){
+				offset_y+= size + text_line_spacing;
+				offset_x= 0.0f;
+				run.m_size.y= offset_y + size;
+				continue;
 			}
+			const Rectangle& rec= font.recs[index];
+			if(codepoint!= ' ' && codepoint!= '\t'){
+				TextRun::Glyph glyph;
+				glyph.m_source= (Rectangle){rec.x - pad, rec.y - pad, rec.width + 2.0f*pad, rec.height + 2.0f*pad};
+				glyph.m_dest= (Rectangle){offset_x + font.glyphs[index].offsetX*scale - pad*scale, offset_y + font.glyphs[index].offsetY*scale - pad*scale,
+										  (rec.width + 2.0f*pad)*scale, (rec.height + 2.0f*pad)*scale};
+				run.m_glyphs.push_back(glyph);
+			}
+			float advance= (font.glyphs[index].advanceX== 0) ? rec.width*scale : font.glyphs[index].advanceX*scale;
+			run.m_size.x= std::max(run.m_size.x, offset_x + advance);
+			offset_x+= advance + spacing;
 		}
 	}
 
-	void Draw() override{
-		Color currentColor= ui_element_body;
-		if(m_is_special){
-			currentColor= IsMouseOver() ? (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) ? ui_element_click : ui_special_h) : ui_special;
-		}
-		else{
-			currentColor= IsMouseOver() ? (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) ? ui_element_click : ui_element_hover) : ui_element_body;
+private:
+	struct Key{
+		unsigned int m_font;
+		int m_base_size;
+		float m_size;
+		float m_spacing;
+		std::string m_text;
+
+		bool operator==(const Key& other) const{
+			return m_font== other.m_font && m_base_size== other.m_base_size && m_size== other.m_size && m_spacing== other.m_spacing && m_text== other.m_text;
 		}
-		//DrawRectangle(static_cast<int>(m_position.x), static_cast<int>(m_position.y), static_cast<int>(m_size.x), static_cast<int>(m_size.y), currentColor);
-		Rectangle rec= {static_cast<float>(m_position.x), static_cast<float>(m_position.y), static_cast<float>(m_size.x), static_cast<float>(m_size.y)};
-		DrawRectangleRounded(rec, 0.3f, 2, currentColor);
-
-		Vector2 pos= { (float)static_cast<int>(m_position.x + m_size.x/2 - MeasureText(m_text.c_str(), font_size)/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
+	};
 
-		if(m_is_special){
-			DrawTextEx(m_font, m_text.c_str(), pos, font_size, 2.0f, ui_panel_header);
-		}
-		else{
-			DrawTextEx(m_font, m_text.c_str(), pos, font_size, 2.0f, ui_text_light);
+	struct KeyHash{
+		size_t operator()(const Key& key) const{
+			size_t hash= std::hash<std::string>()(key.m_text);
+			hash^= std::hash<unsigned int>()(key.m_font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			hash^= std::hash<float>()(key.m_size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			return hash;
 		}
-	}
+	};
+
+	std::unordered_map<Key, TextRun, KeyHash> m_runs;
 };
 
-class CheckBox: public GuiElement{
+//remembers the run of one piece of text, the cache is only consulted again when the text or font changes
+class CachedText{
 public:
-	bool *m_is_true;
-
-	CheckBox(std::string text, bool &is_true){
-		m_text= text;
-		m_is_true= &is_true;
-	}
-
-	void Update() override{
-		if(IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			*m_is_true= !(*m_is_true);
+	const TextRun& Get(const Font& font, std::string_view text, float size= font_size, float spacing= text_spacing){
+		TextCache& cache= TextCache::Get();
+		if(m_run== nullptr || m_generation!= cache.m_generation || m_font!= font.texture.id || m_size!= size || m_spacing!= spacing || m_text!= text){
+			m_text.assign(text.data(), text.size());
+			m_run= &cache.Shape(font, m_text, size, spacing);
+			m_generation= cache.m_generation;
+			m_font= font.texture.id;
+			m_size= size;
+			m_spacing= spacing;
 		}
+		return *m_run;
 	}
 
-	void Draw() override{		Color textColor= IsMouseOver() ? ui_text_hover : ui_text_light;
-
-		// DrawRectangle(static_cast<int>(m_position.x + m_size.x/2), static_cast<int>(m_position.y), static_cast<int>(m_size.x/2), static_cast<int>(m_size.y), ui_element_body);
+private:
+	const TextRun *m_run= nullptr;
+	unsigned int m_generation= 0;
+	unsigned int m_font= 0;
+	float m_size= 0.0f;
+	float m_spacing= 0.0f;
+	std::string m_text;
+};
 
-		Rectangle rec= {static_cast<float>(m_position.x + m_size.x/2), static_cast<float>(m_position.y), static_cast<float>(m_size.x/2), static_cast<float>(m_size.y)};
-		DrawRectangleRounded(rec, 0.3f, 2, ui_element_body);
+//one recorded 2D primitive, see DrawList
+struct DrawCommand{
+	enum Type{ COMMAND_RECT, COMMAND_RECT_ROUNDED, COMMAND_TRIANGLE, COMMAND_TEXTURE, COMMAND_POLYLINE };
+
+	int m_type;
+	int m_group;
+	int m_layer;
+	unsigned int m_texture;		//0 for untextured shapes
+	Vector2 m_texture_size;
+	Rectangle m_dest;
+	Rectangle m_source;
+	Color m_colors[4];			//top-left, bottom-left, bottom-right, top-right
+	Vector2 m_points[3];
+	float m_roundness;
+	int m_segments;
+	int m_first_point;			//polylines: their points in the list's point buffer
+	int m_point_count;
+	float m_thickness;
+	int m_clip;					//index into the list's clip rects, -1 when unclipped
+};
 
-		Vector2 pos_val= { (float)static_cast<int>(m_position.x + m_size.x/2 + m_size.x/4 - MeasureText(b2s(*m_is_true).c_str(), font_size)/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, b2s(*m_is_true).c_str(), pos_val, font_size, 2.0f, ui_text_light);
-		Vector2 pos_text= { (float)static_cast<int>(m_position.x + m_size.x/4 - MeasureText(m_text.c_str(), font_size)/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, m_text.c_str(), pos_text, font_size, 2.0f, textColor);
-	}
+//everything the library asks of the platform: input, time, textures, render targets and submitting draw lists
+//RaylibBackend is the default, HeadlessBackend runs the library without a window or GPU (benchmarks, CI)
+class Backend{
+public:
+	virtual ~Backend(){}
+
+	virtual Vector2 GetMousePosition()= 0;
+	virtual Vector2 GetMouseDelta()= 0;
+	virtual float GetMouseWheelMove()= 0;
+	virtual bool IsMouseButtonPressed(int button)= 0;
+	virtual bool IsMouseButtonDown(int button)= 0;
+	virtual bool IsKeyPressed(int key)= 0;
+	virtual int GetCharPressed()= 0;
+	virtual double GetTime()= 0;
+	virtual float GetFrameTime()= 0;
+	virtual void DisableCursor()= 0;
+	virtual void EnableCursor()= 0;
+	virtual void UpdateCamera(Camera3D& camera)= 0;
+	virtual Vector2 GetScreenSize()= 0;
+	//while waiting the end of a frame blocks until there is input, see SwanGui::Pace()
+	virtual void SetEventWaiting(bool is_waiting)= 0;
+	virtual void WaitTime(double seconds)= 0;
+
+	virtual Font GetDefaultFont()= 0;
+	virtual Texture2D LoadTexture(const Image& image)= 0;
+	//called from loader threads, must not touch the GPU. the image is released with UnloadImage()
+	virtual Image DecodeImage(const std::string& path)= 0;
+	virtual void UpdateTexture(const Texture2D& texture, const void *pixels)= 0;
+	virtual void UnloadTexture(const Texture2D& texture)= 0;
+	virtual void SetTextureFilter(const Texture2D& texture, int filter)= 0;
+	virtual RenderTexture LoadRenderTarget(int width, int height)= 0;
+	virtual void UnloadRenderTarget(const RenderTexture& target)= 0;
+
+	//binds and clears a panel cache, everything submitted until EndPanelTarget() is shifted by -origin
+	virtual void BeginPanelTarget(const RenderTexture& target, Vector2 origin)= 0;
+	virtual void EndPanelTarget()= 0;
+	virtual void RenderScene(const RenderTexture& target, Camera3D& camera, Color background, const std::function<void(Camera3D&)>& draw_scene)= 0;
+	//draws commands in the given order clipped to their clip rect (screen space), returns how many batches that took.
+	//polylines refer to ranges of points
+	virtual int Submit(const std::vector<DrawCommand>& commands, const std::vector<unsigned int>& order, const std::vector<Rectangle>& clips, const std::vector<Vector2>& points)= 0;
 };
 
-inline bool updateSlider(int* target_val, bool is_mouse_over, bool is_active, int step_size= 1, int min= -INT_MAX, int max= INT_MAX, int max_length= 9){
-	if(!target_val) return false;
+class RaylibBackend: public Backend{
+public:
+	Vector2 GetMousePosition() override{ return ::GetMousePosition(); }
+	Vector2 GetMouseDelta() override{ return ::GetMouseDelta(); }
+	float GetMouseWheelMove() override{ return ::GetMouseWheelMove(); }
+	bool IsMouseButtonPressed(int button) override{ return ::IsMouseButtonPressed(button); }
+	bool IsMouseButtonDown(int button) override{ return ::IsMouseButtonDown(button); }
+	bool IsKeyPressed(int key) override{ return ::IsKeyPressed(key); }
+	int GetCharPressed() override{ return ::GetCharPressed(); }
+	double GetTime() override{ return ::GetTime(); }
+	float GetFrameTime() override{ return ::GetFrameTime(); }
+	void DisableCursor() override{ ::DisableCursor(); }
+	void EnableCursor() override{ ::EnableCursor(); }
+	void UpdateCamera(Camera3D& camera) override{ ::UpdateCamera(&camera, CAMERA_CUSTOM); }
+	Vector2 GetScreenSize() override{ return (Vector2){(float)GetScreenWidth(), (float)GetScreenHeight()}; }
+	void SetEventWaiting(bool is_waiting) override{
+		if(is_waiting) EnableEventWaiting();
+		else DisableEventWaiting();
+	}
+	void WaitTime(double seconds) override{ ::WaitTime(seconds); }
+
+	Font GetDefaultFont() override{ return GetFontDefault(); }
+	Texture2D LoadTexture(const Image& image) override{ return LoadTextureFromImage(image); }
+	Image DecodeImage(const std::string& path) override{ return LoadImage(path.c_str()); }
+	void UpdateTexture(const Texture2D& texture, const void *pixels) override{ ::UpdateTexture(texture, pixels); }
+	void UnloadTexture(const Texture2D& texture) override{ ::UnloadTexture(texture); }
+	void SetTextureFilter(const Texture2D& texture, int filter) override{ ::SetTextureFilter(texture, filter); }
+	RenderTexture LoadRenderTarget(int width, int height) override{ return LoadRenderTexture(width, height); }
+	void UnloadRenderTarget(const RenderTexture& target) override{ UnloadRenderTexture(target); }
+
+	void BeginPanelTarget(const RenderTexture& target, Vector2 origin) override{
+		Camera2D panel_space= {0};
+		panel_space.offset= (Vector2){-origin.x, -origin.y};
+		panel_space.zoom= 1.0f;
+
+		m_target_origin= origin;
+		BeginTextureMode(target);
+		ClearBackground(BLANK);
+		//keep the destination alpha opaque where text is blended over the panel body
+		rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+		BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+		BeginMode2D(panel_space);
+	}
 
-	auto clamp_value= [&](int val){ 
-		return std::max(min, std::min(val, max)); 
-	};
+	void EndPanelTarget() override{
+		EndMode2D();
+		EndBlendMode();
+		EndTextureMode();
+		m_target_origin= (Vector2){0, 0};
+	}
 
-	if(is_active){
-		if(IsMouseButtonDown(MOUSE_BUTTON_LEFT)){
-			Vector2 delta= GetMouseDelta();
-			*target_val+= delta.x * step_size;
-		}
+	void RenderScene(const RenderTexture& target, Camera3D& camera, Color background, const std::function<void(Camera3D&)>& draw_scene) override{
+		BeginTextureMode(target);
+			ClearBackground(background);
+			BeginMode3D(camera);
+				if(draw_scene) draw_scene(camera);
+			EndMode3D();
+		EndTextureMode();
+	}
 
-		if(is_mouse_over){
-			*target_val+= GetMouseWheelMove() *step_size;
+	int Submit(const std::vector<DrawCommand>& commands, const std::vector<unsigned int>& order, const std::vector<Rectangle>& clips, const std::vector<Vector2>& points) override{
+		Texture2D shapes= GetShapesTexture();
+		Rectangle shapes_rec= GetShapesTextureRectangle();
+		Vector2 white= {0, 0};
+		if(shapes.width> 0 && shapes.height> 0){
+			white= (Vector2){(shapes_rec.x + shapes_rec.width/2)/shapes.width, (shapes_rec.y + shapes_rec.height/2)/shapes.height};
 		}
 
-		std::string input= std::to_string(*target_val);
-		int key= GetCharPressed();
-
-		while(key > 0){
-			if ((key>= KEY_ZERO) && (key <= KEY_NINE) && 
-				(static_cast<int>(input.length()) < max_length)){
-				input+= static_cast<char>(key);
+		unsigned int bound= UINT_MAX;
+		int clip= -1;
+		int batches= 0;
+		for(unsigned int index : order){
+			const DrawCommand& command= commands[index];
+			unsigned int texture= command.m_texture ? command.m_texture : shapes.id;
+			if(command.m_clip!= clip){
+				//the scissor state flushes the batch, which also drops the bound texture
+				clip= command.m_clip;
+				if(clip< 0) EndScissorMode();
+				else Scissor(clips[clip]);
+				bound= UINT_MAX;
 			}
-			else if(key== KEY_EQUAL || key== KEY_MINUS){
-				*target_val= -*target_val;
-				input= std::to_string(*target_val);
+			if(rlCheckRenderBatchLimit(VertexCount(command))) batches++;
+			if(texture!= bound){
+				rlSetTexture(texture);
+				bound= texture;
+				batches++;
 			}
-			key= GetCharPressed();
+			rlBegin(RL_QUADS);
+				Emit(command, points, white);
+			rlEnd();
 		}
+		rlSetTexture(0);
+		if(clip>= 0) EndScissorMode();
+		return batches;
+	}
 
-		if(IsKeyPressed(KEY_BACKSPACE) && !input.empty()){
-			input.pop_back();
-			if(input.empty() || (input.size()== 1 && input== "-")){
-				input= "0";
-			}
-		}
-		try{
-			int new_value= std::stoi(input);
-			if(new_value >= min && new_value <= max){
-				*target_val= new_value;
-			}
+private:
+	std::vector<std::vector<Vector2>> m_corner_tables;	//unit quarter circles indexed by segment count
+	Vector2 m_target_origin= {0, 0};	//the scissor ignores the panel camera, so clip rects are shifted by hand
+
+	void Scissor(Rectangle clip){
+		int x= (int)std::floor(clip.x - m_target_origin.x);
+		int y= (int)std::floor(clip.y - m_target_origin.y);
+		int width= std::max(0, (int)std::ceil(clip.x + clip.width - m_target_origin.x) - x);
+		int height= std::max(0, (int)std::ceil(clip.y + clip.height - m_target_origin.y) - y);
+		BeginScissorMode(x, y, width, height);
+	}
+
+	//same segment count DrawRectangleRounded() would pick
+	static int CornerSegments(float radius, int segments){
+		if(segments< 4){
+			float th= acosf(2*powf(1 - 0.5f/radius, 2) - 1);
+			segments= (int)(ceilf(2*PI/th)/4.0f);
+			if(segments<= 0) segments= 4;
 		}
-		catch(const std::exception&) {}
+		return std::min(segments, 64);
 	}
-	*target_val= clamp_value(*target_val);
 
-	return true;
-}
+	static float CornerRadius(const DrawCommand& command){
+		return ((command.m_dest.width> command.m_dest.height) ? command.m_dest.height : command.m_dest.width)*command.m_roundness/2;
+	}
 
-class Slider: public GuiElement {
-public:
-	int *m_target_val;
-	int m_step_size= 1;
-	int m_min= -INT_MAX;
-	int m_max=  INT_MAX;
-	bool m_get_input= false;
-	int m_maxLength= 9;
+	int VertexCount(const DrawCommand& command) const{
+		if(command.m_type== DrawCommand::COMMAND_RECT_ROUNDED) return 4*(3 + 4*CornerSegments(CornerRadius(command), command.m_segments));
+		if(command.m_type== DrawCommand::COMMAND_POLYLINE) return 4*std::max(command.m_point_count - 1, 1);
+		return 4;
+	}
 
-	Slider(std::string text, int &target_val, int step_size, int min, int max){
-		m_text= text;
-		m_target_val= &target_val;
-		m_step_size= step_size;
-		m_min= min;
-		m_max= max;
+	const std::vector<Vector2>& CornerTable(int segments){
+		if((int)m_corner_tables.size()<= segments) m_corner_tables.resize(segments + 1);
+		std::vector<Vector2>& table= m_corner_tables[segments];
+		if(table.empty()){
+			for(int i= 0; i<= segments; i++){
+				float angle= (PI/2)*i/segments;
+				table.push_back((Vector2){cosf(angle), sinf(angle)});
+			}
+		}
+		return table;
 	}
 
-	Slider(std::string text, int &target_val, int step_size){
-		m_text= text;
-		m_target_val= &target_val;
-		m_step_size= step_size;
+	static void Vertex(Vector2 uv, Color color, float x, float y){
+		rlColor4ub(color.r, color.g, color.b, color.a);
+		rlTexCoord2f(uv.x, uv.y);
+		rlVertex2f(x, y);
 	}
 
-	Slider(std::string text, int &target_val){
-		m_text= text;
-		m_target_val= &target_val;
+	static void Quad(Rectangle rec, Vector2 uv, Color color){
+		Vertex(uv, color, rec.x, rec.y);
+		Vertex(uv, color, rec.x, rec.y + rec.height);
+		Vertex(uv, color, rec.x + rec.width, rec.y + rec.height);
+		Vertex(uv, color, rec.x + rec.width, rec.y);
 	}
 
-	void Update() override {
-		if(!m_target_val) return;
+	//triangles go out as degenerate quads wound like the rectangles, so they survive backface culling
+	static void Triangle(Vector2 a, Vector2 b, Vector2 c, Vector2 uv, Color color){
+		if((b.x - a.x)*(c.y - a.y) - (b.y - a.y)*(c.x - a.x)> 0) std::swap(b, c);
+		Vertex(uv, color, a.x, a.y);
+		Vertex(uv, color, b.x, b.y);
+		Vertex(uv, color, c.x, c.y);
+		Vertex(uv, color, c.x, c.y);
+	}
 
-		if(IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			m_get_input= true;
-		}
-		else if((!IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) || IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_ENTER)){
-			m_get_input= false;
+	//a line as a quad of the given width, wound like the rectangles
+	static void Segment(Vector2 a, Vector2 b, float thickness, Vector2 uv, Color color){
+		float dx= b.x - a.x, dy= b.y - a.y;
+		float length= sqrtf(dx*dx + dy*dy);
+		if(length< 0.0001f) return;
+		float nx= -dy/length*thickness/2, ny= dx/length*thickness/2;
+		Vector2 corners[4]= {{a.x + nx, a.y + ny}, {a.x - nx, a.y - ny}, {b.x - nx, b.y - ny}, {b.x + nx, b.y + ny}};
+		if((corners[1].x - corners[0].x)*(corners[2].y - corners[0].y) - (corners[1].y - corners[0].y)*(corners[2].x - corners[0].x)> 0){
+			std::swap(corners[1], corners[3]);
 		}
+		for(const Vector2& corner : corners) Vertex(uv, color, corner.x, corner.y);
+	}
 
-		if(m_get_input){
-			int key= GetCharPressed();
-
-			if(IsMouseButtonDown(MOUSE_BUTTON_LEFT)){
-				Vector2 delta= GetMouseDelta();
-				*m_target_val+= delta.x * m_step_size;
-			}
-			else if(IsMouseOver()){
-				*m_target_val+= GetMouseWheelMove() *m_step_size;
-			}
-
-			std::string input= std::to_string(*m_target_val);
-
-			while(key > 0){
-				if((key >= KEY_ZERO) && (key <= KEY_NINE) && (static_cast<int>(input.length()) < m_maxLength)){
-					input+= static_cast<char>(key);
+	void Emit(const DrawCommand& command, const std::vector<Vector2>& points, Vector2 white){
+		const Rectangle& rec= command.m_dest;
+		switch(command.m_type){
+			case DrawCommand::COMMAND_RECT:
+				Vertex(white, command.m_colors[0], rec.x, rec.y);
+				Vertex(white, command.m_colors[1], rec.x, rec.y + rec.height);
+				Vertex(white, command.m_colors[2], rec.x + rec.width, rec.y + rec.height);
+				Vertex(white, command.m_colors[3], rec.x + rec.width, rec.y);
+				break;
+			case DrawCommand::COMMAND_TRIANGLE:
+				Triangle(command.m_points[0], command.m_points[1], command.m_points[2], white, command.m_colors[0]);
+				break;
+			case DrawCommand::COMMAND_RECT_ROUNDED:{
+				float radius= CornerRadius(command);
+				const std::vector<Vector2>& table= CornerTable(CornerSegments(radius, command.m_segments));
+				Color color= command.m_colors[0];
+
+				Quad((Rectangle){rec.x + radius, rec.y, rec.width - 2*radius, radius}, white, color);
+				Quad((Rectangle){rec.x, rec.y + radius, rec.width, rec.height - 2*radius}, white, color);
+				Quad((Rectangle){rec.x + radius, rec.y + rec.height - radius, rec.width - 2*radius, radius}, white, color);
+
+				//corner centers with the sign of the quarter they bulge into
+				const Vector2 centers[4]= {{rec.x + radius, rec.y + radius}, {rec.x + rec.width - radius, rec.y + radius},
+										   {rec.x + rec.width - radius, rec.y + rec.height - radius}, {rec.x + radius, rec.y + rec.height - radius}};
+				const Vector2 signs[4]= {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+				for(int corner= 0; corner< 4; corner++){
+					for(size_t i= 0; i + 1< table.size(); i++){
+						Vector2 a= {centers[corner].x + signs[corner].x*table[i].x*radius, centers[corner].y + signs[corner].y*table[i].y*radius};
+						Vector2 b= {centers[corner].x + signs[corner].x*table[i + 1].x*radius, centers[corner].y + signs[corner].y*table[i + 1].y*radius};
+						Triangle(centers[corner], a, b, white, color);
+					}
 				}
-				else if(key== KEY_EQUAL || key== KEY_MINUS){
-					*m_target_val= -*m_target_val;
-					input= to_string(*m_target_val);
+				break;
+			}
+			case DrawCommand::COMMAND_TEXTURE:{
+				Rectangle src= command.m_source;
+				float width= command.m_texture_size.x, height= command.m_texture_size.y;
+				float u0= src.x/width, u1= (src.x + src.width)/width;
+				float v0= src.y/height, v1= (src.y + src.height)/height;
+				if(src.height< 0){
+					//negative source height flips vertically like DrawTexturePro(), used for render textures
+					v0= (src.y - src.height)/height;
+					v1= src.y/height;
 				}
-				key= GetCharPressed();
+				Color tint= command.m_colors[0];
+				Vertex((Vector2){u0, v0}, tint, rec.x, rec.y);
+				Vertex((Vector2){u0, v1}, tint, rec.x, rec.y + rec.height);
+				Vertex((Vector2){u1, v1}, tint, rec.x + rec.width, rec.y + rec.height);
+				Vertex((Vector2){u1, v0}, tint, rec.x + rec.width, rec.y);
+				break;
 			}
-
-			if(IsKeyPressed(KEY_BACKSPACE) && !input.empty()){
-				input.pop_back();
-				if(input.empty() || (input.size()== 1 && input== "-"))
-					input.push_back('0');
+			case DrawCommand::COMMAND_POLYLINE:{
+				const Vector2 *line= points.data() + command.m_first_point;
+				for(int i= 0; i + 1< command.m_point_count; i++) Segment(line[i], line[i + 1], command.m_thickness, white, command.m_colors[0]);
+				break;
 			}
-
-			try{
-				int newValue= std::stoi(input);
-				if(newValue >= m_min && newValue <= m_max){
-					*m_target_val= newValue;
-				}
-			}catch (const std::exception &e) {}
 		}
-		*m_target_val= std::max(m_min, std::min(* m_target_val, m_max));
-	}
-
-	void Draw() override{
-		Color textColor= IsMouseOver() ? ui_text_hover : ui_text_light;
-		Color currentColor= m_get_input ? ui_element_hover : ui_element_body;
-		Rectangle rec= {static_cast<float>(m_position.x + m_size.x/2), static_cast<float>(m_position.y), static_cast<float>(m_size.x/2), static_cast<float>(m_size.y)};
-		DrawRectangleRounded(rec, 0.3f, 2, currentColor);
-		Vector2 pos_val= { (float)static_cast<int>(m_position.x + m_size.x/2 + m_size.x/4 - MeasureText(to_string(*m_target_val).c_str(), font_size)/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, to_string(*m_target_val).c_str(), pos_val, font_size, 2.0f, ui_text_light);
-		Vector2 pos_text= { (float)static_cast<int>(m_position.x + m_size.x/4 - MeasureText(m_text.c_str(), font_size)/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, m_text.c_str(), pos_text, font_size, 2.0f, textColor);
 	}
 };
 
-class SliderF : public GuiElement{
+//runs without a window: input is scripted, textures are only ids, draw lists are counted instead of drawn
+class HeadlessBackend: public Backend{
 public:
-	float *m_target_val;
-	float m_step_size= 0.1f;
-	float m_min= -FLT_MAX;
-	float m_max= FLT_MAX;
-	bool m_get_input= false;
-	int m_maxLength= 9;
-	std::string m_input_buffer;
+	//scripted input, set before a frame and cleared by EndFrame()
+	Vector2 m_mouse= {0, 0};
+	Vector2 m_mouse_previous= {0, 0};
+	float m_wheel= 0.0f;
+	bool m_buttons_down[3]= {false, false, false};
+	bool m_buttons_pressed[3]= {false, false, false};
+	std::vector<int> m_keys_pressed;
+	std::vector<int> m_chars;
+	size_t m_next_char= 0;
+	double m_time= 0.0;
+	float m_frame_time= 1.0f/60.0f;
+	Vector2 m_screen_size= {1920, 1080};
+	double m_decode_time= 0.0;		//seconds DecodeImage() pretends the file takes to read and decode
+
+	//what the library asked for since the backend was created
+	long long m_commands= 0;
+	long long m_batches= 0;
+	long long m_submits= 0;
+	long long m_panel_passes= 0;
+	long long m_clip_changes= 0;
+	long long m_line_points= 0;		//polyline points submitted
+	long long m_scene_renders= 0;
+	long long m_texture_uploads= 0;
+	bool m_is_event_waiting= false;
+	long long m_waits= 0;			//WaitTime() calls, the clock is not advanced by them
+	double m_waited= 0.0;
+
+	HeadlessBackend(){
+		//fixed width glyphs for ASCII, enough for text layout to do real work
+		m_glyphs.resize(95);
+		m_recs.resize(95);
+		for(int i= 0; i< 95; i++){
+			m_glyphs[i]= GlyphInfo{32 + i, 0, 0, 0, Image{nullptr, 0, 0, 0, 0}};
+			m_recs[i]= (Rectangle){(float)(i % 16)*6, (float)(i / 16)*10, 5, 10};
+		}
+		m_font.baseSize= 10;
+		m_font.glyphCount= 95;
+		m_font.glyphPadding= 0;
+		m_font.texture= (Texture2D){m_next_id++, 96, 60, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE};
+		m_font.recs= m_recs.data();
+		m_font.glyphs= m_glyphs.data();
+	}
 
-	SliderF(std::string text, float &target_val, float step_size, float min, float max){
-		m_text= text;
-		m_target_val= &target_val;
-		m_step_size= step_size;
-		m_min= min;
-		m_max= max;
-		m_input_buffer= format_float(*m_target_val);
+	void MoveMouse(Vector2 position){ m_mouse= position; }
+	void PressButton(int button){ m_buttons_pressed[button]= true; m_buttons_down[button]= true; }
+	void ReleaseButton(int button){ m_buttons_down[button]= false; }
+	void Scroll(float wheel){ m_wheel+= wheel; }
+	void PressKey(int key){ m_keys_pressed.push_back(key); }
+	void TypeChar(int codepoint){ m_chars.push_back(codepoint); }
+
+	//drops the one frame events and advances the clock
+	void EndFrame(){
+		m_mouse_previous= m_mouse;
+		m_wheel= 0.0f;
+		for(bool& pressed : m_buttons_pressed) pressed= false;
+		m_keys_pressed.clear();
+		m_chars.clear();
+		m_next_char= 0;
+		m_time+= m_frame_time;
 	}
 
-	SliderF(std::string text, float &target_val, float step_size){
-		m_text= text;
-		m_target_val= &target_val;
-		m_step_size= step_size;
-		m_input_buffer= format_float(*m_target_val);
+	Vector2 GetMousePosition() override{ return m_mouse; }
+	Vector2 GetMouseDelta() override{ return (Vector2){m_mouse.x - m_mouse_previous.x, m_mouse.y - m_mouse_previous.y}; }
+	float GetMouseWheelMove() override{ return m_wheel; }
+	bool IsMouseButtonPressed(int button) override{ return button>= 0 && button< 3 && m_buttons_pressed[button]; }
+	bool IsMouseButtonDown(int button) override{ return button>= 0 && button< 3 && m_buttons_down[button]; }
+	bool IsKeyPressed(int key) override{ return std::find(m_keys_pressed.begin(), m_keys_pressed.end(), key)!= m_keys_pressed.end(); }
+	int GetCharPressed() override{ return (m_next_char< m_chars.size()) ? m_chars[m_next_char++] : 0; }
+	double GetTime() override{ return m_time; }
+	float GetFrameTime() override{ return m_frame_time; }
+	void DisableCursor() override{}
+	void EnableCursor() override{}
+	void UpdateCamera(Camera3D& camera) override{}
+	Vector2 GetScreenSize() override{ return m_screen_size; }
+	void SetEventWaiting(bool is_waiting) override{ m_is_event_waiting= is_waiting; }
+	void WaitTime(double seconds) override{ m_waits++; m_waited+= seconds; }
+
+	Font GetDefaultFont() override{ return m_font; }
+
+	Texture2D LoadTexture(const Image& image) override{
+		m_texture_uploads++;
+		return (Texture2D){m_next_id++, image.width, image.height, 1, image.format};
 	}
 
-	SliderF(std::string text, float &target_val){
-		m_text= text;
-		m_target_val= &target_val;
-		m_input_buffer= format_float(*m_target_val);
+	//a blank 64x64 image for any path
+	Image DecodeImage(const std::string& path) override{
+		if(m_decode_time> 0.0) std::this_thread::sleep_for(std::chrono::duration<double>(m_decode_time));
+		return (Image){MemAlloc(64*64*4), 64, 64, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
 	}
 
-	void Update() override{
-		if(!m_target_val) return;
+	void UpdateTexture(const Texture2D& texture, const void *pixels) override{ m_texture_uploads++; }
+	void UnloadTexture(const Texture2D& texture) override{}
+	void SetTextureFilter(const Texture2D& texture, int filter) override{}
 
-		if(IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			m_get_input= true;
-		}
-		else if((!IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) || IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_ENTER)){
-			m_get_input= false;
-			m_input_buffer= format_float(*m_target_val);
-		}
+	RenderTexture LoadRenderTarget(int width, int height) override{
+		RenderTexture target= {0};
+		target.id= m_next_id++;
+		target.texture= (Texture2D){m_next_id++, width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+		return target;
+	}
 
-		if(m_get_input){
-			int key= GetCharPressed();
+	void UnloadRenderTarget(const RenderTexture& target) override{}
+	void BeginPanelTarget(const RenderTexture& target, Vector2 origin) override{ m_panel_passes++; }
+	void EndPanelTarget() override{}
 
-			if(IsMouseButtonDown(MOUSE_BUTTON_LEFT)){
-				Vector2 delta= GetMouseDelta();
-				*m_target_val+= delta.x * m_step_size;
-				m_input_buffer= format_float(*m_target_val);
-			}
-		else if(IsMouseOver()){
-				*m_target_val+= GetMouseWheelMove() * m_step_size;
-				m_input_buffer= format_float(*m_target_val);
-			}
+	void RenderScene(const RenderTexture& target, Camera3D& camera, Color background, const std::function<void(Camera3D&)>& draw_scene) override{
+		m_scene_renders++;
+	}
 
-			while (key > 0){
-				if((key >= KEY_ZERO && key <= KEY_NINE) && (static_cast<int>(m_input_buffer.length()) < m_maxLength)){
-					m_input_buffer+= static_cast<char>(key);
-				}
-		else if(key== KEY_PERIOD && m_input_buffer.find('.')== std::string::npos){
-					m_input_buffer+= '.';
-				}
-		else if(key== KEY_MINUS && m_input_buffer.empty()){
-					m_input_buffer= "-";
-				}
-				key= GetCharPressed();
+	//batches are counted the way RaylibBackend splits them: a new one whenever the texture or the clip rect changes
+	int Submit(const std::vector<DrawCommand>& commands, const std::vector<unsigned int>& order, const std::vector<Rectangle>& clips, const std::vector<Vector2>& points) override{
+		unsigned int bound= UINT_MAX;
+		int clip= -1;
+		int batches= 0;
+		for(unsigned int index : order){
+			if(commands[index].m_clip!= clip){
+				clip= commands[index].m_clip;
+				bound= UINT_MAX;
+				m_clip_changes++;
 			}
-			if(IsKeyPressed(KEY_BACKSPACE) && !m_input_buffer.empty()){
-				m_input_buffer.pop_back();
-				if(m_input_buffer.empty() || (m_input_buffer.size()== 1 && m_input_buffer== "-")){
-					m_input_buffer= "0";
-				}
-			}
-			try{
-				float newValue= std::stof(m_input_buffer);
-				if(newValue >= m_min && newValue <= m_max){
-					*m_target_val= newValue;
-				}
-			} catch (const std::exception &e){
-				m_input_buffer= format_float(*m_target_val);
+			if(commands[index].m_texture!= bound){
+				bound= commands[index].m_texture;
+				batches++;
 			}
+			if(commands[index].m_type== DrawCommand::COMMAND_POLYLINE) m_line_points+= commands[index].m_point_count;
 		}
-		*m_target_val= std::max(m_min, std::min(*m_target_val, m_max));
+		m_commands+= (long long)order.size();
+		m_batches+= batches;
+		m_submits++;
+		return batches;
 	}
 
-	void Draw() override{
-		Color textColor= IsMouseOver() ? ui_text_hover : ui_text_light;
-		Color currentColor= m_get_input ? ui_element_hover : ui_element_body;
-		Rectangle rec= {static_cast<float>(m_position.x + m_size.x / 2), static_cast<float>(m_position.y), static_cast<float>(m_size.x / 2), static_cast<float>(m_size.y)};
-		DrawRectangleRounded(rec, 0.3f, 2, currentColor);
+private:
+	Font m_font= {0};
+	std::vector<GlyphInfo> m_glyphs;
+	std::vector<Rectangle> m_recs;
+	unsigned int m_next_id= 1;
+};
 
-		std::string display_value= m_get_input ? m_input_buffer : format_float(*m_target_val);
-		Vector2 pos_val= {(float)static_cast<int>(m_position.x + m_size.x / 2 + m_size.x / 4 - MeasureText(display_value.c_str(), font_size) / 2),
-						(float)static_cast<int>(m_position.y + m_size.y / 2 - font_size / 2.5)};
-		DrawTextEx(m_font, display_value.c_str(), pos_val, font_size, 2.0f, ui_text_light);
+inline RaylibBackend ui_raylib_backend;
+inline Backend *ui_backend= &ui_raylib_backend;	//swap before creating panels to run on another backend
 
-		Vector2 pos_text= {(float)static_cast<int>(m_position.x + m_size.x / 4 - MeasureText(m_text.c_str(), font_size) / 2),
-							(float)static_cast<int>(m_position.y + m_size.y / 2 - font_size / 2.5)};
-		DrawTextEx(m_font, m_text.c_str(), pos_text, font_size, 2.0f, textColor);
-	}
+struct InputEvent{
+	enum Type{ EVENT_MOUSE_MOVE, EVENT_MOUSE_PRESS, EVENT_MOUSE_RELEASE, EVENT_WHEEL, EVENT_KEY, EVENT_CHAR };
 
-private:
-	std::string format_float(float value, int precision= 2){
-		std::ostringstream oss;
-		oss << std::fixed << std::setprecision(precision) << value;
-		return oss.str();
-	}
+	int m_type;
+	int m_code;		//mouse button, key or character
 };
 
-class InputBox: public GuiElement{
+//one frame of input. SwanGui::Update() reads the backend into it once and elements only look at this,
+//so nothing is polled twice and the wheel is used by whoever takes it first
+class InputQueue{
 public:
-	std::string *m_target_str;
-	int m_max_length= 20;
-	bool m_get_input= false;
+	static constexpr int buttons[3]= {MOUSE_BUTTON_LEFT, MOUSE_BUTTON_RIGHT, MOUSE_BUTTON_MIDDLE};
+	static constexpr int keys[3]= {KEY_ESCAPE, KEY_ENTER, KEY_BACKSPACE};
+
+	std::vector<InputEvent> m_events;
+	Vector2 m_mouse= {0, 0};
+	Vector2 m_delta= {0, 0};
+	float m_wheel= 0.0f;		//what is left of this frame's wheel movement
+	unsigned int m_down= 0;		//held buttons, a bit per entry of buttons
+
+	void Collect(){
+		m_events.clear();
+		m_next_char= 0;
+
+		Vector2 mouse= ui_backend->GetMousePosition();
+		if(mouse.x!= m_mouse.x || mouse.y!= m_mouse.y) Push(InputEvent::EVENT_MOUSE_MOVE, 0);
+		m_mouse= mouse;
+		m_delta= ui_backend->GetMouseDelta();
+
+		unsigned int down= 0;
+		for(int i= 0; i< 3; i++){
+			if(ui_backend->IsMouseButtonDown(buttons[i])) down|= 1u << i;
+			if(ui_backend->IsMouseButtonPressed(buttons[i])) Push(InputEvent::EVENT_MOUSE_PRESS, buttons[i]);
+			else if((m_down & (1u << i)) && !(down & (1u << i))) Push(InputEvent::EVENT_MOUSE_RELEASE, buttons[i]);
+		}
+		m_down= down;
 
-	InputBox(std::string text, std::string &target_str, int max_length){
-		m_text= text;
-		m_target_str= &target_str;
-		m_max_length= max_length;
+		m_wheel= ui_backend->GetMouseWheelMove();
+		if(m_wheel!= 0) Push(InputEvent::EVENT_WHEEL, 0);
+		for(int key : keys){
+			if(ui_backend->IsKeyPressed(key)) Push(InputEvent::EVENT_KEY, key);
+		}
+		for(int key= ui_backend->GetCharPressed(); key> 0; key= ui_backend->GetCharPressed()){
+			Push(InputEvent::EVENT_CHAR, key);
+		}
 	}
 
-	InputBox(std::string text, std::string &target_str){
-		m_text= text;
-		m_target_str= &target_str;
-	}
+	bool IsIdle() const{ return m_events.empty(); }
+	bool IsPressed(int button) const{ return Contains(InputEvent::EVENT_MOUSE_PRESS, button); }
+	bool IsKeyPressed(int key) const{ return Contains(InputEvent::EVENT_KEY, key); }
 
-	void Update() override{
-		if(!m_target_str) return;
-		
-		if(IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			m_get_input= true;
+	bool IsDown(int button) const{
+		for(int i= 0; i< 3; i++){
+			if(buttons[i]== button) return (m_down & (1u << i))!= 0;
 		}
-		else if((!IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) || IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_ENTER)){
-			m_get_input= false;
+		return false;
+	}
+
+	//characters typed this frame in order, 0 once they are used up
+	int GetChar(){
+		while(m_next_char< m_events.size()){
+			const InputEvent& event= m_events[m_next_char++];
+			if(event.m_type== InputEvent::EVENT_CHAR) return event.m_code;
 		}
+		return 0;
+	}
 
-		if(m_get_input){
-			int key= GetCharPressed();
+	float TakeWheel(){
+		float wheel= m_wheel;
+		m_wheel= 0.0f;
+		return wheel;
+	}
 
-			std::string input= *m_target_str;
+private:
+	size_t m_next_char= 0;
 
-			while(key > 0){
-				if(static_cast<int>(input.length()) < m_max_length){
-					input+= static_cast<char>(key);
-				}
-				key= GetCharPressed();
-			}
+	void Push(int type, int code){
+		m_events.push_back({type, code});
+	}
 
-			if(IsKeyPressed(KEY_BACKSPACE) && !input.empty()){
-				input.pop_back();
-			}
-			*m_target_str= input;
+	bool Contains(int type, int code) const{
+		for(const InputEvent& event : m_events){
+			if(event.m_type== type && event.m_code== code) return true;
 		}
+		return false;
 	}
+};
 
-	void Draw() override{
-		Color textColor= IsMouseOver() ? ui_text_hover : ui_text_light;
-		Color currentColor= m_get_input ? ui_element_hover : ui_element_body;
+inline InputQueue ui_input;
 
-		Rectangle rec= {static_cast<float>(m_position.x + m_size.x/2), static_cast<float>(m_position.y), static_cast<float>(m_size.x/2), static_cast<float>(m_size.y)};
-		DrawRectangleRounded(rec, 0.3f, 2, currentColor);
-		Vector2 pos_val= { (float)static_cast<int>(m_position.x + m_size.x/2 + m_size.x/4 - MeasureText((*m_target_str).c_str(), font_size)/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, (*m_target_str).c_str(), pos_val, font_size, 2.0f, ui_text_light);
-		Vector2 pos_text= { (float)static_cast<int>(m_position.x + m_size.x/4 - MeasureText(m_text.c_str(), font_size)/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, m_text.c_str(), pos_text, font_size, 2.0f, textColor);
-	}
+//keys, typed characters and drags go to the focused element, it is updated every frame until it loses focus.
+//a click anywhere outside of it takes the focus away before the clicked element gets to update
+class FocusManager{
+public:
+	GuiElement *m_focused= nullptr;
+
+	void SetFocus(GuiElement *element);
+	void ClearFocus(GuiElement *element){ if(m_focused== element) SetFocus(nullptr); }
+	bool HasFocus(const GuiElement *element) const{ return element && m_focused== element; }
+	void Click(GuiElement *hovered);
 };
 
-class Comment: public GuiElement{
+inline FocusManager ui_focus;
+
+//a value another thread owns and the UI shows. the owner writes it with Store() and any thread reads a consistent copy with Load():
+//a seqlock, readers retry while a write is in progress and the writer never waits. the words are relaxed atomics, so a torn
+//read is detected instead of being a data race. edits from the UI are queued in ui_changes, the owner applies them
+template <typename T>
+class SharedValue{
 public:
-	Comment(std::string text){
-		m_text= text;
+	static_assert(std::is_trivially_copyable<T>::value, "SharedValue needs a trivially copyable type");
+
+	std::atomic<int> m_pending{0};		//edits queued for the owner, the UI keeps its own copy until they are applied
+
+	SharedValue(const T& value= T()){ Store(value); }
+	SharedValue(const SharedValue&)= delete;
+	SharedValue& operator=(const SharedValue&)= delete;
+
+	//owner thread only
+	void Store(const T& value){
+		uint32_t words[word_count]= {0};
+		memcpy(words, &value, sizeof(T));
+		unsigned int sequence= m_sequence.load(std::memory_order_relaxed);
+		m_sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		for(int i= 0; i< word_count; i++) m_words[i].store(words[i], std::memory_order_relaxed);
+		m_sequence.store(sequence + 2, std::memory_order_release);
 	}
 
-	void Update() override{}
-
-	void Draw() override{
-		Vector2 pos= { (float)static_cast<int>(m_position.x), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, m_text.c_str(), pos, font_size, 2.0f, ui_text_light);
+	T Load() const{
+		uint32_t words[word_count];
+		unsigned int before, after;
+		do{
+			before= m_sequence.load(std::memory_order_acquire);
+			for(int i= 0; i< word_count; i++) words[i]= m_words[i].load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			after= m_sequence.load(std::memory_order_relaxed);
+		} while((before & 1) || before!= after);
+		T value;
+		memcpy(&value, words, sizeof(T));
+		return value;
 	}
-};
 
-class Thumbnail: public GuiElement{
+private:
+	static constexpr int word_count= (int)((sizeof(T) + 3)/4);
+	std::atomic<unsigned int> m_sequence{0};
+	std::atomic<uint32_t> m_words[word_count];
+};
+
+//edits made in the UI to SharedValues, handed to the owner thread a batch at a time. repeated edits of one value are coalesced
+//into one change. batches are triple buffered: the UI fills one, Publish() swaps it into the middle slot and Apply() swaps that
+//out on the owner's side. a batch the owner has not taken yet is never replaced, the UI keeps coalescing until it is taken.
+//one owner thread calls Apply(), the shared values have to outlive the queued changes
+class ChangeQueue{
+public:
+	static constexpr size_t max_value_size= 16;
+
+	//UI thread
+	template <typename T>
+	void Push(SharedValue<T>& target, const T& value){
+		static_assert(sizeof(T)<= max_value_size, "value too large for a change event");
+		std::vector<Change>& batch= m_batches[m_back];
+		for(Change& change : batch){
+			if(change.m_target== &target){
+				memcpy(change.m_value, &value, sizeof(T));
+				return;
+			}
+		}
+		Change change;
+		change.m_target= &target;
+		change.m_apply= &ApplyTo<T>;
+		memcpy(change.m_value, &value, sizeof(T));
+		target.m_pending.fetch_add(1, std::memory_order_relaxed);
+		batch.push_back(change);
+	}
+
+	//UI thread, once per frame by SwanGui::Update()
+	void Publish(){
+		if(m_batches[m_back].empty() || (m_state.load(std::memory_order_acquire) & is_published)) return;
+		int previous= m_state.exchange(m_back | is_published, std::memory_order_acq_rel);
+		m_back= previous & slot_mask;
+	}
+
+	//owner thread, applies the latest published batch and returns the number of changes in it
+	size_t Apply(){
+		if(!(m_state.load(std::memory_order_acquire) & is_published)) return 0;
+		int previous= m_state.exchange(m_front, std::memory_order_acq_rel);
+		m_front= previous & slot_mask;
+		std::vector<Change>& batch= m_batches[m_front];
+		for(const Change& change : batch) change.m_apply(change.m_target, change.m_value);
+		size_t count= batch.size();
+		batch.clear();
+		return count;
+	}
+
+private:
+	struct Change{
+		void *m_target;
+		void (*m_apply)(void *target, const unsigned char *value);
+		alignas(8) unsigned char m_value[max_value_size];
+	};
+
+	static constexpr int slot_mask= 3;
+	static constexpr int is_published= 4;
+
+	std::vector<Change> m_batches[3];
+	int m_back= 0;				//UI side
+	int m_front= 1;				//owner side
+	std::atomic<int> m_state{2};	//middle slot and whether it holds an unapplied batch
+
+	template <typename T>
+	static void ApplyTo(void *target, const unsigned char *value){
+		SharedValue<T>& shared= *static_cast<SharedValue<T>*>(target);
+		T copy;
+		memcpy(&copy, value, sizeof(T));
+		shared.Store(copy);
+		shared.m_pending.fetch_sub(1, std::memory_order_release);
+	}
+};
+
+inline ChangeQueue ui_changes;
+
+//what a Slider, SliderF, CheckBox or ColorPicker is bound to: a plain variable the UI thread owns, an atomic or a SharedValue.
+//widgets keep a copy, read it once at the start of Update() and CheckDirty(), and hand edits back through Store()
+template <typename T>
+class Binding{
+public:
+	Binding(T& value): m_plain(&value){}
+	Binding(std::atomic<T>& value): m_atomic(&value){}
+	Binding(SharedValue<T>& value): m_shared(&value){}
+
+	T Load() const{
+		if(m_atomic) return m_atomic->load(std::memory_order_acquire);
+		if(m_shared) return m_shared->Load();
+		return *m_plain;
+	}
+
+	//atomics are written right away, shared values get a change event
+	void Store(const T& value){
+		if(m_atomic) m_atomic->store(value, std::memory_order_release);
+		else if(m_shared) ui_changes.Push(*m_shared, value);
+		else *m_plain= value;
+	}
+
+	//false while an edit waits for the owner, the widget's copy is newer than the value until then
+	bool IsSettled() const{
+		return !m_shared || m_shared->m_pending.load(std::memory_order_acquire)== 0;
+	}
+
+	//the copy is only refreshed when it is settled
+	void Sync(T& copy) const{
+		if(IsSettled()) copy= Load();
+	}
+
+private:
+	T *m_plain= nullptr;
+	std::atomic<T> *m_atomic= nullptr;
+	SharedValue<T> *m_shared= nullptr;
+};
+
+//flat list of 2D draw commands, elements record into it and Flush() hands them to the backend sorted into as few texture batches as possible
+class DrawList{
+public:
+	using Command= DrawCommand;
+	//inside one group shapes go first, then images, then text, elements of a panel never overlap so this keeps the layering
+	enum Layer{ LAYER_SHAPES, LAYER_IMAGES, LAYER_TEXT };
+
+	std::vector<Command> m_commands;
+	std::vector<Rectangle> m_clips;
+	std::vector<Vector2> m_points;		//polyline points
+	int m_group= 0;
+	int m_depth= 0;				//open DrawScopes, the outermost one flushes
+	int m_clip= -1;				//clip rect new commands get, -1 for none
+
+	void NextGroup(){ m_group++; }
+
+	//clips everything recorded until PopClip() to the rect, nested clips only keep the overlap.
+	//a clip starts and ends a group, so sorting never mixes commands with different clips
+	void PushClip(Rectangle rec){
+		if(m_clip>= 0) rec= GetCollisionRec(rec, m_clips[m_clip]);
+		m_clip_stack.push_back(m_clip);
+		m_clip= (int)m_clips.size();
+		m_clips.push_back(rec);
+		NextGroup();
+	}
+
+	void PopClip(){
+		if(m_clip_stack.empty()) return;
+		m_clip= m_clip_stack.back();
+		m_clip_stack.pop_back();
+		NextGroup();
+	}
+
+	Rectangle GetClip() const{
+		return (m_clip>= 0) ? m_clips[m_clip] : (Rectangle){-FLT_MAX/2, -FLT_MAX/2, FLT_MAX, FLT_MAX};
+	}
+
+	void AddRect(Rectangle rec, Color color){
+		AddRectGradient(rec, color, color, color, color);
+	}
+
+	void AddRectGradient(Rectangle rec, Color top_left, Color bottom_left, Color bottom_right, Color top_right){
+		Command& command= Push(DrawCommand::COMMAND_RECT, LAYER_SHAPES);
+		command.m_dest= rec;
+		command.m_colors[0]= top_left;
+		command.m_colors[1]= bottom_left;
+		command.m_colors[2]= bottom_right;
+		command.m_colors[3]= top_right;
+	}
+
+	void AddRectGradientH(Rectangle rec, Color left, Color right){ AddRectGradient(rec, left, left, right, right); }
+	void AddRectGradientV(Rectangle rec, Color top, Color bottom){ AddRectGradient(rec, top, bottom, bottom, top); }
+
+	void AddRectLines(Rectangle rec, Color color){
+		AddRect((Rectangle){rec.x, rec.y, rec.width, 1}, color);
+		AddRect((Rectangle){rec.x + rec.width - 1, rec.y + 1, 1, rec.height - 2}, color);
+		AddRect((Rectangle){rec.x, rec.y + rec.height - 1, rec.width, 1}, color);
+		AddRect((Rectangle){rec.x, rec.y + 1, 1, rec.height - 2}, color);
+	}
+
+	void AddRectRounded(Rectangle rec, float roundness, int segments, Color color){
+		if(roundness<= 0.0f || rec.width< 1 || rec.height< 1){
+			AddRect(rec, color);
+			return;
+		}
+		Command& command= Push(DrawCommand::COMMAND_RECT_ROUNDED, LAYER_SHAPES);
+		command.m_dest= rec;
+		command.m_colors[0]= color;
+		command.m_roundness= std::min(roundness, 1.0f);
+		command.m_segments= segments;
+	}
+
+	void AddTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color){
+		Command& command= Push(DrawCommand::COMMAND_TRIANGLE, LAYER_SHAPES);
+		command.m_points[0]= v1;
+		command.m_points[1]= v2;
+		command.m_points[2]= v3;
+		command.m_colors[0]= color;
+	}
+
+	void AddTexture(const Texture2D& texture, Rectangle source, Rectangle dest, Color tint, int layer= LAYER_IMAGES){
+		if(texture.id== 0) return;
+		Command& command= Push(DrawCommand::COMMAND_TEXTURE, layer);
+		command.m_texture= texture.id;
+		command.m_texture_size= (Vector2){(float)texture.width, (float)texture.height};
+		command.m_source= source;
+		command.m_dest= dest;
+		command.m_colors[0]= tint;
+	}
+
+	void AddTextureEx(const Texture2D& texture, Vector2 position, float scale, Color tint){
+		AddTexture(texture, (Rectangle){0, 0, (float)texture.width, (float)texture.height}, (Rectangle){position.x, position.y, texture.width*scale, texture.height*scale}, tint);
+	}
+
+	void AddTextureRec(const Texture2D& texture, Rectangle source, Vector2 position, Color tint){
+		AddTexture(texture, source, (Rectangle){position.x, position.y, std::fabs(source.width), std::fabs(source.height)}, tint);
+	}
+
+	//one command however many points, the backend draws every segment as a quad
+	void AddPolyline(const Vector2 *points, int count, float thickness, Color color){
+		if(count< 2) return;
+		Command& command= Push(DrawCommand::COMMAND_POLYLINE, LAYER_SHAPES);
+		command.m_first_point= (int)m_points.size();
+		command.m_point_count= count;
+		command.m_thickness= thickness;
+		command.m_colors[0]= color;
+		m_points.insert(m_points.end(), points, points + count);
+	}
+
+	void AddText(const Font& font, const TextRun& run, Vector2 position, Color tint){
+		for(const auto& glyph : run.m_glyphs){
+			Rectangle dest= {position.x + glyph.m_dest.x, position.y + glyph.m_dest.y, glyph.m_dest.width, glyph.m_dest.height};
+			AddTexture(font.texture, glyph.m_source, dest, tint, LAYER_TEXT);
+		}
+	}
+
+	//sorts by (group, layer, texture) keeping the recorded order otherwise, then emits every run of equal textures as one batch
+	void Flush(){
+		if(m_commands.empty()) return;
+
+		m_keys.resize(m_commands.size());
+		for(size_t i= 0; i< m_commands.size(); i++){
+			const Command& command= m_commands[i];
+			m_keys[i]= ((unsigned long long)command.m_group << 44) | ((unsigned long long)command.m_layer << 42) |
+					   ((unsigned long long)(command.m_texture & 0xFFFFF) << 22) | (unsigned long long)(i & 0x3FFFFF);
+		}
+		//the index only has 22 bits, past that submit in recorded order
+		bool sorted= m_commands.size()<= 0x3FFFFF;
+		if(sorted) std::sort(m_keys.begin(), m_keys.end());
+
+		m_order.resize(m_keys.size());
+		for(size_t i= 0; i< m_keys.size(); i++){
+			m_order[i]= sorted ? (unsigned int)(m_keys[i] & 0x3FFFFF) : (unsigned int)i;
+		}
+		int batches= ui_backend->Submit(m_commands, m_order, m_clips, m_points);
+
+		ui_frame_stats.draw_commands+= (int)m_commands.size();
+		ui_frame_stats.draw_batches+= batches;
+		m_commands.clear();
+		m_points.clear();
+		m_group= 0;
+		//clips still open keep their rect, the next commands refer to it
+		if(m_clip_stack.empty()) m_clips.clear();
+	}
+
+private:
+	std::vector<unsigned long long> m_keys;
+	std::vector<unsigned int> m_order;
+	std::vector<int> m_clip_stack;
+
+	Command& Push(int type, int layer){
+		m_commands.emplace_back();
+		Command& command= m_commands.back();
+		command.m_type= type;
+		command.m_group= m_group;
+		command.m_layer= layer;
+		command.m_texture= 0;
+		command.m_clip= m_clip;
+		return command;
+	}
+};
+
+inline DrawList ui_frame_list;
+inline DrawList *ui_draw_list= &ui_frame_list;	//the list elements currently record into
+
+//makes a list current for its lifetime, the outermost scope on a list submits it
+class DrawScope{
+public:
+	DrawScope(DrawList& list): m_list(list), m_previous(ui_draw_list){
+		ui_draw_list= &list;
+		m_list.m_depth++;
+	}
+
+	~DrawScope(){
+		if(--m_list.m_depth== 0) m_list.Flush();
+		ui_draw_list= m_previous;
+	}
+
+private:
+	DrawList& m_list;
+	DrawList *m_previous;
+};
+
+//clips what is recorded into the current list while it lives
+class ClipScope{
+public:
+	ClipScope(Rectangle rec): m_list(*ui_draw_list){
+		m_list.PushClip(rec);
+	}
+
+	~ClipScope(){
+		m_list.PopClip();
+	}
+
+private:
+	DrawList& m_list;
+};
+
+inline void DrawTextRun(const Font& font, const TextRun& run, Vector2 position, Color tint){
+	ui_draw_list->AddText(font, run, position, tint);
+}
+
+//stands in for an image that is still loading or could not be loaded
+inline void DrawPlaceholder(Rectangle rec){
+	ui_draw_list->AddRectRounded(rec, 0.1f, 2, ui_element_body);
+}
+
+class Panel;
+class Button;
+class CheckBox;
+class Slider;
+class Comment;
+class Thumbnail;
+class ThumnailGif;
+class Billboard;
+class BillboardGif;
+class CameraView;
+class CameraView3D;
+class CameraView3DFill;
+class ColorPicker;
+
+//value formatting for the draw path, writes into a caller's stack buffer so nothing is allocated
+typedef char ValueBuffer[32];
+
+inline std::string_view format_int(ValueBuffer& buffer, int value){
+	auto result= std::to_chars(buffer, buffer + sizeof(ValueBuffer), value);
+	return std::string_view(buffer, result.ptr - buffer);
+}
+
+inline std::string_view format_float(ValueBuffer& buffer, float value, int precision= 2){
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars>= 201611L
+	auto result= std::to_chars(buffer, buffer + sizeof(ValueBuffer), value, std::chars_format::fixed, precision);
+	if(result.ec== std::errc()) return std::string_view(buffer, result.ptr - buffer);
+#endif
+	int length= snprintf(buffer, sizeof(ValueBuffer), "%.*f", precision, value);
+	return std::string_view(buffer, std::clamp(length, 0, (int)sizeof(ValueBuffer) - 1));
+}
+
+inline std::string to_string(int value){
+	ValueBuffer buffer;
+	return std::string(format_int(buffer, value));
+}
+
+inline const char* b2s(bool value){
+	return value ? "Enabled" : "Disabled";
+}
+
+//applies typed digits, sign flips and backspace to an int, only touches the value when a key was used
+inline void editIntValue(int* target_val, int min, int max, int max_length){
+	int key= ui_input.GetChar();
+	bool is_backspace= ui_input.IsKeyPressed(KEY_BACKSPACE);
+	if(key<= 0 && !is_backspace) return;
+
+	ValueBuffer input;
+	int length= (int)format_int(input, *target_val).size();
+	bool is_edited= false;
+	while(key> 0){
+		if((key>= KEY_ZERO) && (key<= KEY_NINE) && length< max_length){
+			input[length++]= static_cast<char>(key);
+			is_edited= true;
+		}
+		else if(key== KEY_EQUAL || key== KEY_MINUS){
+			*target_val= -*target_val;
+			length= (int)format_int(input, *target_val).size();
+		}
+		key= ui_input.GetChar();
+	}
+
+	if(is_backspace && length> 0){
+		length--;
+		if(length== 0 || (length== 1 && input[0]== '-')){
+			input[0]= '0';
+			length= 1;
+		}
+		is_edited= true;
+	}
+
+	if(is_edited){
+		int new_value= 0;
+		auto result= std::from_chars(input, input + length, new_value);
+		if(result.ec== std::errc() && new_value>= min && new_value<= max){
+			*target_val= new_value;
+		}
+	}
+}
+
+class GuiElement {//_______________________________________________________________________________ GUI ELEMENTS ____________________________________________________________________________//
+public:
+	Vector2 m_position= {0, 0};
+	Vector2 m_size= {0, 0};
+	std::string m_text;
+	CachedText m_label;
+	Font m_font;
+	bool m_is_visible= true;
+	bool m_is_dirty= true;
+	bool m_was_hovered= false;
+	bool m_was_pressed= false;
+	unsigned int m_hit_generation= 0;
+	GuiElement *m_parent= nullptr;		//panel that lays the element out
+	int m_layout_index= -1;
+	unsigned int m_place_version= 0;	//width of the parent the element was last given its x and width for
+	bool m_is_hidden= false;			//hidden elements take no space in the layout
+	float m_preferred_height= 0.0f;		//replaces MeasureHeight() when set
+	bool m_wants_update= false;			//updated every frame, not only when input is routed to it
+
+	virtual ~GuiElement(){
+		if(ui_focus.m_focused== this) ui_focus.m_focused= nullptr;
+	}
+
+	virtual void Update()= 0;
+	virtual void Draw()= 0;
+
+	//height the element wants in a column of the given width, panels cache it until the width or the element changes
+	virtual float MeasureHeight(float width){ return (float)font_size; }
+	//MeasureHeight() uses the width, panels measure the element again when their width changes. asked once, when it is added
+	virtual bool HeightDependsOnWidth() const{ return false; }
+	//takes whatever height is left below it in the panel
+	virtual bool FillsPanel() const{ return false; }
+	//takes the whole width of its column, without the side padding around other elements
+	virtual bool SpansColumn() const{ return false; }
+	//a child at this index changed its size or visibility
+	virtual void InvalidateLayout(int index){}
+	//panels and groups, their children are laid out, hit tested and culled through them
+	virtual bool IsContainer() const{ return false; }
+	//the element got or lost the keyboard focus
+	virtual void FocusChanged(bool is_focused){}
+	//a child started or stopped asking for an Update() every frame
+	virtual void ChildWantsUpdate(GuiElement *child, bool wants_update){}
+	//the element changes on its own and needs frames without input, keeps SwanGui::Pace() from sleeping
+	virtual bool IsAnimating() const{ return false; }
+
+	//called once per frame by the owning panel, returns true if the element looks different than the last time it was drawn
+	virtual bool CheckDirty(){
+		bool is_hovered= IsMouseOver();
+		bool is_pressed= is_hovered && ui_input.IsPressed(MOUSE_BUTTON_LEFT);
+		if(is_hovered!= m_was_hovered || is_pressed!= m_was_pressed){
+			m_was_hovered= is_hovered;
+			m_was_pressed= is_pressed;
+			m_is_dirty= true;
+		}
+		return m_is_dirty;
+	}
+	//render targets have to be filled before the panel binds its own cache
+	virtual void DrawOffscreen(){}
+	//drawn after the cached panel contents, not clipped to the panel (e.g. drop down menus)
+	virtual void DrawOverlay(){}
+
+	virtual void SetPosition(Vector2 pos){ m_position= pos; m_is_dirty= true; ui_layout_version++; }
+	void SetSize(Vector2 size){ m_size= size; m_is_dirty= true; ui_layout_version++; }
+	void SetFont(Font font){m_font= font; m_is_dirty= true;};
+	void MarkDirty(){ m_is_dirty= true; }
+	void SetHidden(bool is_hidden){
+		if(m_is_hidden== is_hidden) return;
+		m_is_hidden= is_hidden;
+		RequestLayout();
+	}
+	void SetPreferredHeight(float height){
+		m_preferred_height= height;
+		RequestLayout();
+	}
+	void RequestLayout(){
+		m_is_dirty= true;
+		if(m_parent) m_parent->InvalidateLayout(m_layout_index);
+	}
+	void SetWantsUpdate(bool wants_update){
+		if(m_wants_update== wants_update) return;
+		m_wants_update= wants_update;
+		if(m_parent) m_parent->ChildWantsUpdate(this, wants_update);
+	}
+	bool IsFocused() const{ return ui_focus.HasFocus(this); }
+
+	bool IsMouseOver() const;
+	bool IsMouseOverEx(Vector2 position, Vector2 size) const;
+};
+
+inline bool GuiElement::IsMouseOver() const{
+	//elements in the current hit index were already resolved by SwanGui this frame
+	if(m_hit_generation!= 0 && m_hit_generation== ui_hover.m_generation){
+		return this== ui_hover.m_element || this== ui_hover.m_panel;
+	}
+	return IsMouseOverEx(m_position, m_size);
+}
+
+inline void FocusManager::SetFocus(GuiElement *element){
+	if(m_focused== element) return;
+	GuiElement *previous= m_focused;
+	m_focused= element;
+	if(previous) previous->FocusChanged(false);
+	if(element) element->FocusChanged(true);
+}
+
+//clicks inside the focused element or one of its children keep the focus
+inline void FocusManager::Click(GuiElement *hovered){
+	for(GuiElement *element= hovered; element; element= element->m_parent){
+		if(element== m_focused) return;
+	}
+	SetFocus(nullptr);
+}
+
+inline bool GuiElement::IsMouseOverEx(Vector2 position, Vector2 size) const{
+	Vector2 mousePos= (ui_hover.m_generation!= 0) ? ui_hover.m_mouse : ui_backend->GetMousePosition();
+	return (mousePos.x >= position.x && mousePos.x <= position.x + size.x && mousePos.y >= position.y && mousePos.y <= position.y + size.y);
+}
+
+//profiling zones, build with -DSWANGUI_PROFILE to enable them, otherwise they compile to nothing
+#ifdef SWANGUI_PROFILE
+enum ZoneKind{ ZONE_GUI_UPDATE, ZONE_GUI_DRAW, ZONE_PANEL_UPDATE, ZONE_PANEL_DRAW, ZONE_ELEMENT_UPDATE, ZONE_ELEMENT_DRAW };
+
+//collects zone timings during a frame and publishes a summary in EndFrame()
+class Profiler{
+public:
+	static constexpr int history_size= 240;
+	static constexpr int slowest_count= 8;
+
+	struct Sample{
+		const GuiElement *m_owner= nullptr;
+		int m_kind= 0;
+		float m_us= 0.0f;
+		std::string m_label;
+	};
+
+	struct PanelCost{
+		const GuiElement *m_panel= nullptr;
+		std::string m_label;
+		float m_update_us= 0.0f;	//smoothed over the last frames
+		float m_draw_us= 0.0f;
+	};
+
+	float m_frame_us[history_size]= {0};	//ring buffer of Update + Draw time per frame
+	int m_frame_index= 0;
+	int m_frame_count= 0;
+	std::vector<Sample> m_slowest;			//slowest element zones of the last frame, slowest first
+	std::vector<PanelCost> m_panels;		//costliest first
+	unsigned int m_version= 0;				//bumped every published frame
+
+	static Profiler& Get(){
+		static Profiler profiler;
+		return profiler;
+	}
+
+	void Record(int kind, const GuiElement *owner, float us){
+		switch(kind){
+			case ZONE_GUI_UPDATE:
+			case ZONE_GUI_DRAW:
+				m_current_us+= us;
+				break;
+			case ZONE_PANEL_UPDATE:
+			case ZONE_PANEL_DRAW:{
+				PanelTime& time= m_panel_times[owner];
+				(kind== ZONE_PANEL_UPDATE ? time.m_update : time.m_draw)+= us;
+				break;
+			}
+			default:{
+				//keep the slowest few without sorting every sample
+				if(m_pending_count== slowest_count && us<= m_pending[slowest_count - 1].m_us) break;
+				int i= std::min(m_pending_count, slowest_count - 1);
+				while(i> 0 && m_pending[i - 1].m_us< us){
+					m_pending[i]= m_pending[i - 1];
+					i--;
+				}
+				m_pending[i].m_owner= owner;
+				m_pending[i].m_kind= kind;
+				m_pending[i].m_us= us;
+				m_pending_count= std::min(m_pending_count + 1, slowest_count);
+				break;
+			}
+		}
+	}
+
+	void EndFrame(){
+		m_frame_us[m_frame_index]= m_current_us;
+		m_frame_index= (m_frame_index + 1) % history_size;
+		m_frame_count= std::min(m_frame_count + 1, history_size);
+		m_current_us= 0.0f;
+
+		m_slowest.resize(m_pending_count);
+		for(int i= 0; i< m_pending_count; i++){
+			m_slowest[i].m_owner= m_pending[i].m_owner;
+			m_slowest[i].m_kind= m_pending[i].m_kind;
+			m_slowest[i].m_us= m_pending[i].m_us;
+			m_slowest[i].m_label= m_pending[i].m_owner->m_text;
+		}
+		m_pending_count= 0;
+
+		for(auto& panel : m_panels){
+			auto it= m_panel_times.find(panel.m_panel);
+			PanelTime time= (it!= m_panel_times.end()) ? it->second : PanelTime();
+			panel.m_update_us= panel.m_update_us*0.9f + time.m_update*0.1f;
+			panel.m_draw_us= panel.m_draw_us*0.9f + time.m_draw*0.1f;
+			if(it!= m_panel_times.end()) m_panel_times.erase(it);
+		}
+		for(auto& [owner, time] : m_panel_times){
+			m_panels.push_back(PanelCost{owner, owner->m_text, time.m_update, time.m_draw});
+		}
+		m_panel_times.clear();
+		std::sort(m_panels.begin(), m_panels.end(), [](const PanelCost& a, const PanelCost& b){
+			return a.m_update_us + a.m_draw_us> b.m_update_us + b.m_draw_us;
+		});
+		m_version++;
+	}
+
+	//drops panels that no longer exist, the profiler only keeps raw pointers to them
+	void Forget(const GuiElement *panel){
+		m_panels.erase(std::remove_if(m_panels.begin(), m_panels.end(), [&](const PanelCost& cost){ return cost.m_panel== panel; }), m_panels.end());
+		m_panel_times.erase(panel);
+		for(auto& sample : m_slowest){
+			if(sample.m_owner== panel) sample.m_owner= nullptr;
+		}
+	}
+
+private:
+	struct PanelTime{
+		float m_update= 0.0f;
+		float m_draw= 0.0f;
+	};
+
+	float m_current_us= 0.0f;
+	Sample m_pending[slowest_count];
+	int m_pending_count= 0;
+	std::unordered_map<const GuiElement*, PanelTime> m_panel_times;
+};
+
+class ProfileZone{
+public:
+	ProfileZone(int kind, const GuiElement *owner): m_kind(kind), m_owner(owner), m_start(std::chrono::steady_clock::now()){}
+
+	~ProfileZone(){
+		std::chrono::duration<float, std::micro> elapsed= std::chrono::steady_clock::now() - m_start;
+		Profiler::Get().Record(m_kind, m_owner, elapsed.count());
+	}
+
+private:
+	int m_kind;
+	const GuiElement *m_owner;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+#define SWANGUI_ZONE_NAME(line) swangui_zone_##line
+#define SWANGUI_ZONE_LINE(line, kind, owner) ProfileZone SWANGUI_ZONE_NAME(line)(kind, owner)
+#define SWANGUI_ZONE(kind, owner) SWANGUI_ZONE_LINE(__LINE__, kind, owner)
+#else
+#define SWANGUI_ZONE(kind, owner)
+#endif
+
+//uniform grid over the rectangles of every interactive element, rebuilt only when the layout changes
+class HitGrid{
+public:
+	struct Entry{
+		Rectangle m_rect;
+		GuiElement *m_element;
+		int m_layer;		//draw order of the owning panel, higher is on top
+		bool m_is_panel;
+	};
+
+	float m_cell_size= 64.0f;
+	Vector2 m_cell= {64.0f, 64.0f};	//actual cell extent, grows for very large layouts so the grid stays bounded
+	int m_columns= 0;
+	int m_rows= 0;
+	Vector2 m_origin= {0, 0};
+	std::vector<Entry> m_entries;
+	std::vector<int> m_cell_start;
+	std::vector<int> m_cell_items;
+
+	void Clear(){
+		m_entries.clear();
+	}
+
+	void Add(Rectangle rect, GuiElement *element, int layer, bool is_panel){
+		if(rect.width<= 0 || rect.height<= 0) return;
+		m_entries.push_back({rect, element, layer, is_panel});
+	}
+
+	void Build(){
+		m_columns= 0;
+		m_rows= 0;
+		m_cell_start.clear();
+		m_cell_items.clear();
+		if(m_entries.empty()) return;
+
+		float min_x= FLT_MAX, min_y= FLT_MAX, max_x= -FLT_MAX, max_y= -FLT_MAX;
+		for(const auto& entry : m_entries){
+			min_x= std::min(min_x, entry.m_rect.x);
+			min_y= std::min(min_y, entry.m_rect.y);
+			max_x= std::max(max_x, entry.m_rect.x + entry.m_rect.width);
+			max_y= std::max(max_y, entry.m_rect.y + entry.m_rect.height);
+		}
+		m_origin= (Vector2){min_x, min_y};
+		m_cell.x= std::max(m_cell_size, (max_x - min_x)/255.0f);
+		m_cell.y= std::max(m_cell_size, (max_y - min_y)/255.0f);
+		m_columns= static_cast<int>((max_x - min_x)/m_cell.x) + 1;
+		m_rows= static_cast<int>((max_y - min_y)/m_cell.y) + 1;
+
+		//counting sort of entries into cells, every cell is a contiguous run of entry indices
+		m_cell_start.assign(m_columns*m_rows + 1, 0);
+		for(int pass= 0; pass< 2; pass++){
+			for(int i= 0; i< (int)m_entries.size(); i++){
+				int x0, y0, x1, y1;
+				CellRange(m_entries[i].m_rect, x0, y0, x1, y1);
+				for(int y= y0; y<= y1; y++){
+					for(int x= x0; x<= x1; x++){
+						int cell= y*m_columns + x;
+						if(pass== 0) m_cell_start[cell + 1]++;
+						else m_cell_items[m_cell_start[cell] + m_fill[cell]++]= i;
+					}
+				}
+			}
+			if(pass== 0){
+				for(int c= 0; c< m_columns*m_rows; c++) m_cell_start[c + 1]+= m_cell_start[c];
+				m_cell_items.assign(m_cell_start.back(), 0);
+				m_fill.assign(m_columns*m_rows, 0);
+			}
+		}
+	}
+
+	//returns the topmost panel and the element inside it that contain the point
+	void Query(Vector2 point, GuiElement *&panel, GuiElement *&element) const{
+		panel= nullptr;
+		element= nullptr;
+		if(m_columns== 0) return;
+
+		int x= static_cast<int>((point.x - m_origin.x)/m_cell.x);
+		int y= static_cast<int>((point.y - m_origin.y)/m_cell.y);
+		if(point.x< m_origin.x || point.y< m_origin.y || x>= m_columns || y>= m_rows) return;
+
+		int cell= y*m_columns + x;
+		int top_layer= -1;
+		for(int i= m_cell_start[cell]; i< m_cell_start[cell + 1]; i++){
+			const Entry& entry= m_entries[m_cell_items[i]];
+			if(entry.m_is_panel && entry.m_layer> top_layer && Contains(entry.m_rect, point)){
+				top_layer= entry.m_layer;
+				panel= entry.m_element;
+			}
+		}
+		if(!panel) return;
+		for(int i= m_cell_start[cell]; i< m_cell_start[cell + 1]; i++){
+			const Entry& entry= m_entries[m_cell_items[i]];
+			if(!entry.m_is_panel && entry.m_layer== top_layer && Contains(entry.m_rect, point)){
+				element= entry.m_element;
+			}
+		}
+	}
+
+private:
+	std::vector<int> m_fill;
+
+	static bool Contains(const Rectangle& rect, Vector2 point){
+		return point.x >= rect.x && point.x <= rect.x + rect.width && point.y >= rect.y && point.y <= rect.y + rect.height;
+	}
+
+	void CellRange(const Rectangle& rect, int& x0, int& y0, int& x1, int& y1) const{
+		x0= std::clamp(static_cast<int>((rect.x - m_origin.x)/m_cell.x), 0, m_columns - 1);
+		y0= std::clamp(static_cast<int>((rect.y - m_origin.y)/m_cell.y), 0, m_rows - 1);
+		x1= std::clamp(static_cast<int>((rect.x + rect.width - m_origin.x)/m_cell.x), 0, m_columns - 1);
+		y1= std::clamp(static_cast<int>((rect.y + rect.height - m_origin.y)/m_cell.y), 0, m_rows - 1);
+	}
+};
+
+class Button: public GuiElement{
 public:
-	Texture2D *m_texture;
 	std::function<void()> m_call_back_function;
-	std::string m_text_button;
+	bool m_is_special;
+
+	Button(const std::string text, std::function<void()> call_back_function, bool is_special){
+		m_text= text;
+		m_call_back_function= call_back_function;
+		m_is_special= is_special;
+	}
+
+	Button(const std::string text, std::function<void()> call_back_function){
+		m_text= text;
+		m_call_back_function= call_back_function;
+		m_is_special= false;
+	}
+
+	void Update() override{
+		if(IsMouseOver() && ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			if(m_call_back_function){
+				m_call_back_function();
+			}
+		}
+	}
+
+	void Draw() override{
+		Color currentColor= ui_element_body;
+		if(m_is_special){
+			currentColor= IsMouseOver() ? (ui_input.IsPressed(MOUSE_BUTTON_LEFT) ? ui_element_click : ui_special_h) : ui_special;
+		}
+		else{
+			currentColor= IsMouseOver() ? (ui_input.IsPressed(MOUSE_BUTTON_LEFT) ? ui_element_click : ui_element_hover) : ui_element_body;
+		}
+		//DrawRectangle(static_cast<int>(m_position.x), static_cast<int>(m_position.y), static_cast<int>(m_size.x), static_cast<int>(m_size.y), currentColor);
+		Rectangle rec= {static_cast<float>(m_position.x), static_cast<float>(m_position.y), static_cast<float>(m_size.x), static_cast<float>(m_size.y)};
+		ui_draw_list->AddRectRounded(rec, 0.3f, 2, currentColor);
+
+		const TextRun& label= m_label.Get(m_font, m_text);
+		Vector2 pos= { (float)static_cast<int>(m_position.x + m_size.x/2 - label.m_size.x/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
+
+		if(m_is_special){
+			DrawTextRun(m_font, label, pos, ui_panel_header);
+		}
+		else{
+			DrawTextRun(m_font, label, pos, ui_text_light);
+		}
+	}
+};
+
+class CheckBox: public GuiElement{
+public:
+	Binding<bool> m_target;
+	bool m_value= false;
+	bool m_drawn_value= false;
+	CachedText m_value_label;
+
+	CheckBox(std::string text, Binding<bool> is_true): m_target(is_true){
+		m_text= text;
+		m_value= m_target.Load();
+	}
+
+	void Update() override{
+		m_target.Sync(m_value);
+		if(IsMouseOver() && ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			m_value= !m_value;
+			m_target.Store(m_value);
+		}
+	}
+
+	bool CheckDirty() override{
+		m_target.Sync(m_value);
+		if(m_value!= m_drawn_value){
+			m_drawn_value= m_value;
+			m_is_dirty= true;
+		}
+		return GuiElement::CheckDirty();
+	}
+
+	void Draw() override{		Color textColor= IsMouseOver() ? ui_text_hover : ui_text_light;
+
+		// DrawRectangle(static_cast<int>(m_position.x + m_size.x/2), static_cast<int>(m_position.y), static_cast<int>(m_size.x/2), static_cast<int>(m_size.y), ui_element_body);
+
+		Rectangle rec= {static_cast<float>(m_position.x + m_size.x/2), static_cast<float>(m_position.y), static_cast<float>(m_size.x/2), static_cast<float>(m_size.y)};
+		ui_draw_list->AddRectRounded(rec, 0.3f, 2, ui_element_body);
+
+		const TextRun& value= m_value_label.Get(m_font, b2s(m_value));
+		Vector2 pos_val= { (float)static_cast<int>(m_position.x + m_size.x/2 + m_size.x/4 - value.m_size.x/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, value, pos_val, ui_text_light);
+		const TextRun& label= m_label.Get(m_font, m_text);
+		Vector2 pos_text= { (float)static_cast<int>(m_position.x + m_size.x/4 - label.m_size.x/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, label, pos_text, textColor);
+	}
+};
+
+inline bool updateSlider(int* target_val, bool is_mouse_over, bool is_active, int step_size= 1, int min= -INT_MAX, int max= INT_MAX, int max_length= 9){
+	if(!target_val) return false;
+
+	auto clamp_value= [&](int val){ 
+		return std::max(min, std::min(val, max)); 
+	};
+
+	if(is_active){
+		if(ui_input.IsDown(MOUSE_BUTTON_LEFT)){
+			Vector2 delta= ui_input.m_delta;
+			*target_val+= delta.x * step_size;
+		}
+
+		if(is_mouse_over){
+			*target_val+= ui_input.TakeWheel() *step_size;
+		}
+
+		editIntValue(target_val, min, max, max_length);
+	}
+	*target_val= clamp_value(*target_val);
+
+	return true;
+}
+
+class Slider: public GuiElement {
+public:
+	Binding<int> m_target;
+	int m_value= 0;
+	int m_step_size= 1;
+	int m_min= -INT_MAX;
+	int m_max=  INT_MAX;
+	bool m_get_input= false;
+	int m_maxLength= 9;
+	int m_drawn_value= 0;
+	bool m_drawn_input= false;
+	CachedText m_value_label;
+
+	Slider(std::string text, Binding<int> target_val, int step_size, int min, int max): m_target(target_val){
+		m_text= text;
+		m_value= m_target.Load();
+		m_step_size= step_size;
+		m_min= min;
+		m_max= max;
+	}
+
+	Slider(std::string text, Binding<int> target_val, int step_size): m_target(target_val){
+		m_text= text;
+		m_value= m_target.Load();
+		m_step_size= step_size;
+	}
+
+	Slider(std::string text, Binding<int> target_val): m_target(target_val){
+		m_text= text;
+		m_value= m_target.Load();
+	}
+
+	void Update() override {
+		m_target.Sync(m_value);
+		int value= m_value;
+
+		if(IsMouseOver() && ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			ui_focus.SetFocus(this);
+		}
+		else if(ui_input.IsKeyPressed(KEY_ESCAPE) || ui_input.IsKeyPressed(KEY_ENTER)){
+			ui_focus.ClearFocus(this);
+		}
+
+		if(m_get_input){
+			if(ui_input.IsDown(MOUSE_BUTTON_LEFT)){
+				Vector2 delta= ui_input.m_delta;
+				m_value+= delta.x * m_step_size;
+			}
+			else if(IsMouseOver()){
+				m_value+= ui_input.TakeWheel() *m_step_size;
+			}
+
+			editIntValue(&m_value, m_min, m_max, m_maxLength);
+		}
+		m_value= std::max(m_min, std::min(m_value, m_max));
+		if(m_value!= value) m_target.Store(m_value);
+	}
+
+	void FocusChanged(bool is_focused) override{
+		m_get_input= is_focused;
+	}
+
+	bool CheckDirty() override{
+		m_target.Sync(m_value);
+		if(m_value!= m_drawn_value || m_get_input!= m_drawn_input){
+			m_drawn_value= m_value;
+			m_drawn_input= m_get_input;
+			m_is_dirty= true;
+		}
+		return GuiElement::CheckDirty();
+	}
+
+	void Draw() override{
+		Color textColor= IsMouseOver() ? ui_text_hover : ui_text_light;
+		Color currentColor= m_get_input ? ui_element_hover : ui_element_body;
+		Rectangle rec= {static_cast<float>(m_position.x + m_size.x/2), static_cast<float>(m_position.y), static_cast<float>(m_size.x/2), static_cast<float>(m_size.y)};
+		ui_draw_list->AddRectRounded(rec, 0.3f, 2, currentColor);
+		ValueBuffer buffer;
+		const TextRun& value= m_value_label.Get(m_font, format_int(buffer, m_value));
+		Vector2 pos_val= { (float)static_cast<int>(m_position.x + m_size.x/2 + m_size.x/4 - value.m_size.x/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, value, pos_val, ui_text_light);
+		const TextRun& label= m_label.Get(m_font, m_text);
+		Vector2 pos_text= { (float)static_cast<int>(m_position.x + m_size.x/4 - label.m_size.x/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, label, pos_text, textColor);
+	}
+};
+
+class SliderF : public GuiElement{
+public:
+	Binding<float> m_target;
+	float m_value= 0.0f;
+	float m_step_size= 0.1f;
+	float m_min= -FLT_MAX;
+	float m_max= FLT_MAX;
+	bool m_get_input= false;
+	int m_maxLength= 9;
+	std::string m_input_buffer;
+	float m_drawn_value= 0.0f;
+	bool m_drawn_input= false;
+	CachedText m_value_label;
+
+	SliderF(std::string text, Binding<float> target_val, float step_size, float min, float max): m_target(target_val){
+		m_text= text;
+		m_value= m_target.Load();
+		m_step_size= step_size;
+		m_min= min;
+		m_max= max;
+		SetInputBuffer(m_value);
+	}
+
+	SliderF(std::string text, Binding<float> target_val, float step_size): m_target(target_val){
+		m_text= text;
+		m_value= m_target.Load();
+		m_step_size= step_size;
+		SetInputBuffer(m_value);
+	}
+
+	SliderF(std::string text, Binding<float> target_val): m_target(target_val){
+		m_text= text;
+		m_value= m_target.Load();
+		SetInputBuffer(m_value);
+	}
+
+	void Update() override{
+		m_target.Sync(m_value);
+		float value= m_value;
+
+		if(IsMouseOver() && ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			ui_focus.SetFocus(this);
+		}
+		else if(ui_input.IsKeyPressed(KEY_ESCAPE) || ui_input.IsKeyPressed(KEY_ENTER)){
+			ui_focus.ClearFocus(this);
+		}
+
+		if(m_get_input){
+			int key= ui_input.GetChar();
+
+			if(ui_input.IsDown(MOUSE_BUTTON_LEFT)){
+				Vector2 delta= ui_input.m_delta;
+				m_value+= delta.x * m_step_size;
+				SetInputBuffer(m_value);
+			}
+		else if(IsMouseOver()){
+				m_value+= ui_input.TakeWheel() * m_step_size;
+				SetInputBuffer(m_value);
+			}
+
+			while (key > 0){
+				if((key >= KEY_ZERO && key <= KEY_NINE) && (static_cast<int>(m_input_buffer.length()) < m_maxLength)){
+					m_input_buffer+= static_cast<char>(key);
+				}
+		else if(key== KEY_PERIOD && m_input_buffer.find('.')== std::string::npos){
+					m_input_buffer+= '.';
+				}
+		else if(key== KEY_MINUS && m_input_buffer.empty()){
+					m_input_buffer= "-";
+				}
+				key= ui_input.GetChar();
+			}
+			if(ui_input.IsKeyPressed(KEY_BACKSPACE) && !m_input_buffer.empty()){
+				m_input_buffer.pop_back();
+				if(m_input_buffer.empty() || (m_input_buffer.size()== 1 && m_input_buffer== "-")){
+					m_input_buffer= "0";
+				}
+			}
+			float newValue= 0.0f;
+			if(ParseFloat(m_input_buffer, newValue)){
+				if(newValue >= m_min && newValue <= m_max){
+					m_value= newValue;
+				}
+			}
+			else{
+				SetInputBuffer(m_value);
+			}
+		}
+		m_value= std::max(m_min, std::min(m_value, m_max));
+		if(m_value!= value) m_target.Store(m_value);
+	}
+
+	void FocusChanged(bool is_focused) override{
+		m_get_input= is_focused;
+		if(!is_focused) SetInputBuffer(m_value);
+	}
+
+	bool CheckDirty() override{
+		m_target.Sync(m_value);
+		//while typing the buffer can change without the value changing
+		if(m_value!= m_drawn_value || m_get_input || m_get_input!= m_drawn_input){
+			m_drawn_value= m_value;
+			m_drawn_input= m_get_input;
+			m_is_dirty= true;
+		}
+		return GuiElement::CheckDirty();
+	}
+
+	void Draw() override{
+		Color textColor= IsMouseOver() ? ui_text_hover : ui_text_light;
+		Color currentColor= m_get_input ? ui_element_hover : ui_element_body;
+		Rectangle rec= {static_cast<float>(m_position.x + m_size.x / 2), static_cast<float>(m_position.y), static_cast<float>(m_size.x / 2), static_cast<float>(m_size.y)};
+		ui_draw_list->AddRectRounded(rec, 0.3f, 2, currentColor);
+
+		ValueBuffer buffer;
+		const TextRun& value= m_value_label.Get(m_font, m_get_input ? std::string_view(m_input_buffer) : format_float(buffer, m_value));
+		Vector2 pos_val= {(float)static_cast<int>(m_position.x + m_size.x / 2 + m_size.x / 4 - value.m_size.x / 2),
+						(float)static_cast<int>(m_position.y + m_size.y / 2 - font_size / 2.5)};
+		DrawTextRun(m_font, value, pos_val, ui_text_light);
+
+		const TextRun& label= m_label.Get(m_font, m_text);
+		Vector2 pos_text= {(float)static_cast<int>(m_position.x + m_size.x / 4 - label.m_size.x / 2),
+							(float)static_cast<int>(m_position.y + m_size.y / 2 - font_size / 2.5)};
+		DrawTextRun(m_font, label, pos_text, textColor);
+	}
+
+private:
+	//reuses the buffer's capacity, so dragging the value doesn't allocate
+	void SetInputBuffer(float value){
+		ValueBuffer buffer;
+		std::string_view text= format_float(buffer, value);
+		m_input_buffer.assign(text.data(), text.size());
+	}
+
+	//strtof instead of stof, a half typed "-" or "." fails without throwing
+	static bool ParseFloat(const std::string& text, float& value){
+		char *end= nullptr;
+		value= strtof(text.c_str(), &end);
+		return end!= text.c_str();
+	}
+};
+
+class InputBox: public GuiElement{
+public:
+	std::string *m_target_str;
+	int m_max_length= 20;
+	bool m_get_input= false;
+	std::string m_drawn_text;
+	bool m_drawn_input= false;
+	CachedText m_value_label;
+
+	InputBox(std::string text, std::string &target_str, int max_length){
+		m_text= text;
+		m_target_str= &target_str;
+		m_max_length= max_length;
+	}
+
+	InputBox(std::string text, std::string &target_str){
+		m_text= text;
+		m_target_str= &target_str;
+	}
+
+	void Update() override{
+		if(!m_target_str) return;
+		
+		if(IsMouseOver() && ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			ui_focus.SetFocus(this);
+		}
+		else if(ui_input.IsKeyPressed(KEY_ESCAPE) || ui_input.IsKeyPressed(KEY_ENTER)){
+			ui_focus.ClearFocus(this);
+		}
+
+		if(m_get_input){
+			//edits the bound string in place instead of copying it every frame
+			int key= ui_input.GetChar();
+			while(key > 0){
+				if(static_cast<int>(m_target_str->length()) < m_max_length){
+					m_target_str->push_back(static_cast<char>(key));
+				}
+				key= ui_input.GetChar();
+			}
+
+			if(ui_input.IsKeyPressed(KEY_BACKSPACE) && !m_target_str->empty()){
+				m_target_str->pop_back();
+			}
+		}
+	}
+
+	void FocusChanged(bool is_focused) override{
+		m_get_input= is_focused;
+	}
+
+	bool CheckDirty() override{
+		if(m_get_input!= m_drawn_input || *m_target_str!= m_drawn_text){
+			m_drawn_text= *m_target_str;
+			m_drawn_input= m_get_input;
+			m_is_dirty= true;
+		}
+		return GuiElement::CheckDirty();
+	}
+
+	void Draw() override{
+		Color textColor= IsMouseOver() ? ui_text_hover : ui_text_light;
+		Color currentColor= m_get_input ? ui_element_hover : ui_element_body;
+
+		Rectangle rec= {static_cast<float>(m_position.x + m_size.x/2), static_cast<float>(m_position.y), static_cast<float>(m_size.x/2), static_cast<float>(m_size.y)};
+		ui_draw_list->AddRectRounded(rec, 0.3f, 2, currentColor);
+		const TextRun& value= m_value_label.Get(m_font, *m_target_str);
+		Vector2 pos_val= { (float)static_cast<int>(m_position.x + m_size.x/2 + m_size.x/4 - value.m_size.x/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, value, pos_val, ui_text_light);
+		const TextRun& label= m_label.Get(m_font, m_text);
+		Vector2 pos_text= { (float)static_cast<int>(m_position.x + m_size.x/4 - label.m_size.x/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, label, pos_text, textColor);
+	}
+};
+
+class Comment: public GuiElement{
+public:
+	Comment(std::string text){
+		m_text= text;
+	}
+
+	void Update() override{}
+
+	void Draw() override{
+		Vector2 pos= { (float)static_cast<int>(m_position.x), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, m_label.Get(m_font, m_text), pos, ui_text_light);
+	}
+};
+
+//an image or animation that is decoded on a loader thread and turned into textures on the main thread.
+//elements draw a placeholder until it is ready, m_version tells them when to redraw
+class Asset{
+public:
+	std::string m_path;
+	unsigned int m_version= 0;		//bumped whenever what the asset shows changes, main thread only
+
+	virtual ~Asset(){}
+
+	//loader thread: file i/o and decoding, nothing that touches the GPU
+	virtual void Decode()= 0;
+	//main thread, after Decode()
+	virtual void Upload()= 0;
+
+	//main thread, true once the upload ran, also when the file could not be read
+	bool IsReady() const{ return m_is_ready; }
+
+protected:
+	bool m_is_ready= false;
+};
+
+class TextureAsset: public Asset{
+public:
+	Texture2D m_texture= {0};
+
+	TextureAsset(const std::string& path){
+		m_path= path;
+	}
+
+	~TextureAsset(){
+		if(m_image.data) UnloadImage(m_image);
+		if(m_texture.id> 0) ui_backend->UnloadTexture(m_texture);
+	}
+
+	void Decode() override{
+		m_image= ui_backend->DecodeImage(m_path);
+	}
+
+	void Upload() override{
+		if(m_image.data){
+			m_texture= ui_backend->LoadTexture(m_image);
+			UnloadImage(m_image);
+			m_image.data= nullptr;
+		}
+		m_is_ready= true;
+		m_version++;
+	}
+
+private:
+	Image m_image= {0};
+};
+
+//decodes assets on a few worker threads and uploads the results on the main thread within a time budget per frame.
+//SwanGui::Update() calls Upload(), so building a UI never waits for its images however many there are
+class AssetLoader{
+public:
+	static AssetLoader& Get(){
+		static AssetLoader loader;
+		return loader;
+	}
+
+	~AssetLoader(){
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_is_stopping= true;
+		}
+		m_wake.notify_all();
+		for(std::thread& worker : m_workers) worker.join();
+	}
+
+	//queues the asset for a worker, or decodes and uploads it right away when ui_load_async is off
+	void Load(std::shared_ptr<Asset> asset){
+		if(!ui_load_async){
+			asset->Decode();
+			asset->Upload();
+			return;
+		}
+		m_pending++;
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(m_workers.empty()) StartWorkers();
+		m_queue.push_back(std::move(asset));
+		m_wake.notify_one();
+	}
+
+	//main thread: uploads decoded assets in the order they finished until budget seconds are used, the first one always goes
+	int Upload(float budget){
+		if(m_pending== 0) return 0;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for(auto& asset : m_decoded) m_uploads.push_back(std::move(asset));
+			m_decoded.clear();
+		}
+		auto start= std::chrono::steady_clock::now();
+		int count= 0;
+		while(!m_uploads.empty()){
+			if(count> 0 && std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count()>= budget) break;
+			m_uploads.front()->Upload();
+			m_uploads.pop_front();
+			m_pending--;
+			count++;
+		}
+		return count;
+	}
+
+	//blocks until everything queued so far is uploaded, for tools that want everything before the first frame
+	void Finish(){
+		while(m_pending> 0){
+			if(Upload(FLT_MAX)== 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	//queued, decoding or waiting for the upload
+	int GetPending() const{ return m_pending; }
+
+	//one texture per path, shared while someone holds it
+	std::shared_ptr<TextureAsset> AcquireTexture(const std::string& path){
+		auto it= m_textures.find(path);
+		if(it!= m_textures.end()){
+			if(auto texture= it->second.lock()) return texture;
+		}
+		auto texture= std::make_shared<TextureAsset>(path);
+		m_textures[path]= texture;
+		Load(texture);
+		return texture;
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::deque<std::shared_ptr<Asset>> m_queue;			//waiting for a worker
+	std::vector<std::shared_ptr<Asset>> m_decoded;		//waiting for the main thread
+	std::deque<std::shared_ptr<Asset>> m_uploads;		//main thread side, left over from earlier frames
+	std::vector<std::thread> m_workers;
+	bool m_is_stopping= false;
+	int m_pending= 0;									//main thread only
+	std::unordered_map<std::string, std::weak_ptr<TextureAsset>> m_textures;
+
+	void StartWorkers(){
+		int count= (ui_loader_threads> 0) ? ui_loader_threads : std::clamp((int)std::thread::hardware_concurrency() - 1, 1, 4);
+		for(int i= 0; i< count; i++) m_workers.emplace_back([this](){ Work(); });
+	}
+
+	void Work(){
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for(;;){
+			m_wake.wait(lock, [&](){ return m_is_stopping || !m_queue.empty(); });
+			if(m_is_stopping) return;
+			std::shared_ptr<Asset> asset= std::move(m_queue.front());
+			m_queue.pop_front();
+			lock.unlock();
+			asset->Decode();
+			lock.lock();
+			m_decoded.push_back(std::move(asset));
+		}
+	}
+};
+
+class Thumbnail: public GuiElement{
+public:
+	Texture2D *m_texture;
+	std::shared_ptr<TextureAsset> m_asset;	//set when the thumbnail loads its own image
+	unsigned int m_drawn_version= 0;
+	std::function<void()> m_call_back_function;
+	std::string m_text_button;
+	CachedText m_button_label;
+
+	Thumbnail(std::string text, Texture2D &texture, std::function<void()> call_back_function, std::string text_button){
+		m_text= text;
+		m_texture= &texture;
+		m_call_back_function= call_back_function;
+		m_text_button= text_button;
+	}
+
+	//loads the image in the background, a placeholder is drawn until it is there
+	Thumbnail(std::string text, const std::string& path, std::function<void()> call_back_function, std::string text_button){
+		m_text= text;
+		m_asset= AssetLoader::Get().AcquireTexture(path);
+		m_texture= &m_asset->m_texture;
+		m_call_back_function= call_back_function;
+		m_text_button= text_button;
+	}
+
+	bool IsAnimating() const override{ return m_asset && !m_asset->IsReady(); }
+
+	bool CheckDirty() override{
+		if(m_asset && m_asset->m_version!= m_drawn_version){
+			m_drawn_version= m_asset->m_version;
+			m_is_dirty= true;
+		}
+		return GuiElement::CheckDirty();
+	}
+
+	float MeasureHeight(float width) override{
+		return font_size *2 + element_padding;
+	}
+
+	void Update() override{
+		if(IsMouseOver() && ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			if(m_call_back_function){
+				m_call_back_function();
+			}
+		}
+	}
+
+	void Draw() override{
+		Color currentColor= IsMouseOver() ? (ui_input.IsPressed(MOUSE_BUTTON_LEFT) ? ui_element_click : ui_element_hover) : ui_element_body;
+		//DrawRectangle(static_cast<int>(m_position.x + thumnnail_size + element_padding), static_cast<int>(m_position.y +m_size.y/2),
+		//			  static_cast<int>(m_size.x - thumnnail_size - element_padding), static_cast<int>(m_size.y/2), currentColor);
+		Rectangle rec= {static_cast<float>(m_position.x + thumnnail_size + element_padding), static_cast<float>(m_position.y +m_size.y/2),
+						static_cast<float>(m_size.x - thumnnail_size - element_padding), static_cast<float>(m_size.y/2)};
+		ui_draw_list->AddRectRounded(rec, 0.3f, 2, currentColor);
+		const TextRun& button_label= m_button_label.Get(m_font, m_text_button);
+		Vector2 pos= { (float)static_cast<int>(m_position.x + thumnnail_size + element_padding + (m_size.x - thumnnail_size - element_padding)/2 - button_label.m_size.x/2),
+					(float)static_cast<int>(m_position.y + 3*(m_size.y/4) - font_size/2.5)};
+		DrawTextRun(m_font, button_label, pos, ui_text_light);
+
+		if(m_texture->id== 0){
+			DrawPlaceholder((Rectangle){m_position.x, m_position.y, thumnnail_size, thumnnail_size});
+		}
+		else{
+			float scale= (m_texture->width> m_texture->height) ? thumnnail_size/(m_texture->width) : thumnnail_size/(m_texture->height);
+			ui_draw_list->AddTextureEx(*m_texture, m_position, scale, WHITE);
+		}
+
+		Vector2 pos2= { (float)static_cast<int>(m_position.x + thumnnail_size + element_padding), (float)static_cast<int>(m_position.y + m_size.y/4 - font_size/2.5)};
+		DrawTextRun(m_font, m_label.Get(m_font, m_text), pos2, ui_text_light);
+	}
+};
+
+//keeps a gif in its compressed form and decodes one frame at a time into a single RGBA canvas,
+//so memory stays at file size + one canvas no matter how many frames there are
+class GifStream{
+public:
+	struct Frame{
+		int m_left, m_top, m_width, m_height;
+		bool m_interlaced;
+		size_t m_palette;		//offset of the color table in m_data
+		int m_palette_size;
+		size_t m_lzw;			//offset of the lzw minimum code size byte
+		int m_disposal;
+		int m_transparent;		//-1 when the frame has no transparent index
+		int m_delay;			//in hundredths of a second
+	};
+
+	std::vector<Frame> m_frames;
+	int m_width= 0;
+	int m_height= 0;
+	int m_current= -1;
+
+	bool Open(const std::string& path){
+		int size= 0;
+		unsigned char *data= LoadFileData(path.c_str(), &size);
+		if(data== nullptr) return false;
+		std::vector<unsigned char> bytes(data, data + size);
+		UnloadFileData(data);
+		if(!Open(std::move(bytes))){
+			TraceLog(LOG_WARNING, "GIF: [%s] Failed to parse gif", path.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	bool Open(std::vector<unsigned char> bytes){
+		m_data= std::move(bytes);
+		m_frames.clear();
+		m_current= -1;
+		if(!Parse()){
+			m_data.clear();
+			m_frames.clear();
+			m_width= m_height= 0;
+			return false;
+		}
+		m_canvas.assign((size_t)m_width*m_height*4, 0);
+		m_indices.resize((size_t)m_width*m_height);
+		for(const Frame& frame : m_frames){
+			if(frame.m_disposal== 3){
+				m_previous.resize(m_canvas.size());
+				break;
+			}
+		}
+		return true;
+	}
+
+	bool IsReady() const{ return !m_frames.empty(); }
+	int GetFrameCount() const{ return (int)m_frames.size(); }
+
+	//RGBA pixels of the current frame, decodes the first one if nothing was decoded yet
+	const unsigned char* Pixels(){
+		if(m_current< 0) Next();
+		return m_canvas.data();
+	}
+
+	//advances to the next frame, wrapping back to the first, and returns its pixels
+	const unsigned char* Next(){
+		if(m_frames.empty()) return m_canvas.data();
+		int next= m_current + 1;
+		if(next>= (int)m_frames.size()) next= 0;
+
+		if(next== 0) std::fill(m_canvas.begin(), m_canvas.end(), 0);
+		else Dispose(m_frames[m_current]);
+
+		const Frame& frame= m_frames[next];
+		if(frame.m_disposal== 3) Backup(frame);
+		Decode(frame);
+		m_current= next;
+		return m_canvas.data();
+	}
+
+	//drops the compressed data and the canvas, once every frame is on the gpu they aren't needed
+	void Close(){
+		std::vector<unsigned char>().swap(m_data);
+		std::vector<unsigned char>().swap(m_canvas);
+		std::vector<unsigned char>().swap(m_previous);
+		std::vector<unsigned char>().swap(m_indices);
+		m_current= -1;
+	}
+
+	size_t GetMemoryUsage() const{
+		return m_data.capacity() + m_canvas.capacity() + m_previous.capacity() + m_indices.capacity() + m_frames.capacity()*sizeof(Frame);
+	}
+
+private:
+	std::vector<unsigned char> m_data;
+	std::vector<unsigned char> m_canvas;
+	std::vector<unsigned char> m_previous;	//only allocated when a frame asks to restore what was under it
+	std::vector<unsigned char> m_indices;	//palette indices of the frame being decoded
+
+	int Read16(size_t pos) const{ return m_data[pos] | (m_data[pos + 1] << 8); }
+
+	//skips a chain of data sub-blocks, returns false if it runs past the end
+	bool SkipBlocks(size_t& pos) const{
+		while(pos< m_data.size()){
+			int length= m_data[pos++];
+			if(length== 0) return true;
+			pos+= length;
+		}
+		return false;
+	}
+
+	bool Parse(){
+		if(m_data.size()< 13 || m_data[0]!= 'G' || m_data[1]!= 'I' || m_data[2]!= 'F') return false;
+		m_width= Read16(6);
+		m_height= Read16(8);
+		if(m_width<= 0 || m_height<= 0) return false;
+
+		size_t pos= 13;
+		size_t global_palette= 0;
+		int global_size= 0;
+		if(m_data[10] & 0x80){
+			global_palette= pos;
+			global_size= 2 << (m_data[10] & 7);
+			pos+= global_size*3;
+			if(pos> m_data.size()) return false;
+		}
+
+		int disposal= 0, transparent= -1, delay= 0;
+		while(pos< m_data.size()){
+			unsigned char block= m_data[pos++];
+			if(block== 0x3B) break;
+			if(block== 0x21){
+				if(pos + 1> m_data.size()) return false;
+				unsigned char label= m_data[pos++];
+				if(label== 0xF9 && pos + 5< m_data.size() && m_data[pos]== 4){
+					unsigned char flags= m_data[pos + 1];
+					disposal= (flags >> 2) & 7;
+					delay= Read16(pos + 2);
+					transparent= (flags & 1) ? m_data[pos + 4] : -1;
+				}
+				if(!SkipBlocks(pos)) return false;
+			}
+			else if(block== 0x2C){
+				if(pos + 9> m_data.size()) return false;
+				Frame frame;
+				frame.m_left= Read16(pos);
+				frame.m_top= Read16(pos + 2);
+				frame.m_width= Read16(pos + 4);
+				frame.m_height= Read16(pos + 6);
+				unsigned char flags= m_data[pos + 8];
+				frame.m_interlaced= flags & 0x40;
+				pos+= 9;
+				if(flags & 0x80){
+					frame.m_palette= pos;
+					frame.m_palette_size= 2 << (flags & 7);
+					pos+= frame.m_palette_size*3;
+					if(pos> m_data.size()) return false;
+				}
+				else{
+					frame.m_palette= global_palette;
+					frame.m_palette_size= global_size;
+				}
+				frame.m_lzw= pos;
+				frame.m_disposal= disposal;
+				frame.m_transparent= transparent;
+				frame.m_delay= delay;
+				if(frame.m_lzw>= m_data.size()) break;
+				if(frame.m_palette_size> 0) m_frames.push_back(frame);
+				//a truncated last frame still decodes as far as its data goes
+				pos++;
+				if(!SkipBlocks(pos)) break;
+				disposal= 0;
+				transparent= -1;
+				delay= 0;
+			}
+			else{
+				break;
+			}
+		}
+		return !m_frames.empty();
+	}
+
+	//walks the clipped frame rectangle row by row
+	template <typename F>
+	void ForEachRow(const Frame& frame, F fn){
+		int x0= std::max(frame.m_left, 0), x1= std::min(frame.m_left + frame.m_width, m_width);
+		int y0= std::max(frame.m_top, 0), y1= std::min(frame.m_top + frame.m_height, m_height);
+		if(x0>= x1) return;
+		for(int y= y0; y< y1; y++){
+			fn((size_t)(y*m_width + x0)*4, (size_t)(x1 - x0)*4);
+		}
+	}
+
+	void Dispose(const Frame& frame){
+		if(frame.m_disposal== 2){
+			ForEachRow(frame, [&](size_t offset, size_t length){
+				std::fill(m_canvas.begin() + offset, m_canvas.begin() + offset + length, 0);
+			});
+		}
+		else if(frame.m_disposal== 3 && !m_previous.empty()){
+			ForEachRow(frame, [&](size_t offset, size_t length){
+				std::copy(m_previous.begin() + offset, m_previous.begin() + offset + length, m_canvas.begin() + offset);
+			});
+		}
+	}
+
+	void Backup(const Frame& frame){
+		ForEachRow(frame, [&](size_t offset, size_t length){
+			std::copy(m_canvas.begin() + offset, m_canvas.begin() + offset + length, m_previous.begin() + offset);
+		});
+	}
+
+	//lzw decodes the frame into m_indices, returns how many pixels were produced
+	size_t DecodeIndices(const Frame& frame){
+		size_t count= (size_t)frame.m_width*frame.m_height;
+		if(m_indices.size()< count) m_indices.resize(count);
+
+		size_t pos= frame.m_lzw;
+		int min_size= m_data[pos++];
+		if(min_size< 1 || min_size> 11) return 0;
+
+		unsigned short prefix[4096];
+		unsigned char suffix[4096];
+		unsigned char stack[4097];
+		const int clear= 1 << min_size;
+		const int end= clear + 1;
+		for(int i= 0; i< clear; i++){
+			prefix[i]= 0;
+			suffix[i]= (unsigned char)i;
+		}
+
+		int code_size= min_size + 1;
+		int next= clear + 2;
+		int old= -1;
+		unsigned char first= 0;
+		unsigned int bits= 0;
+		int bit_count= 0;
+		int block_left= 0;
+		size_t written= 0;
+
+		while(written< count){
+			while(bit_count< code_size){
+				if(block_left== 0){
+					if(pos>= m_data.size() || m_data[pos]== 0) return written;
+					block_left= m_data[pos++];
+				}
+				if(pos>= m_data.size()) return written;
+				bits|= (unsigned int)m_data[pos++] << bit_count;
+				bit_count+= 8;
+				block_left--;
+			}
+			int code= bits & ((1 << code_size) - 1);
+			bits>>= code_size;
+			bit_count-= code_size;
+
+			if(code== clear){
+				code_size= min_size + 1;
+				next= clear + 2;
+				old= -1;
+				continue;
+			}
+			if(code== end) break;
+			if(old== -1){
+				if(code>= clear) return written;
+				first= (unsigned char)code;
+				m_indices[written++]= first;
+				old= code;
+				continue;
+			}
+
+			int in_code= code;
+			int top= 0;
+			if(code>= next){
+				if(code> next) return written;
+				stack[top++]= first;
+				code= old;
+			}
+			while(code>= clear){
+				stack[top++]= suffix[code];
+				code= prefix[code];
+			}
+			first= suffix[code];
+			stack[top++]= first;
+
+			if(next< 4096){
+				prefix[next]= (unsigned short)old;
+				suffix[next]= first;
+				next++;
+				if(next== (1 << code_size) && code_size< 12) code_size++;
+			}
+			old= in_code;
+
+			while(top> 0 && written< count){
+				m_indices[written++]= stack[--top];
+			}
+		}
+		return written;
+	}
+
+	void Decode(const Frame& frame){
+		size_t decoded= DecodeIndices(frame);
+		const unsigned char *palette= m_data.data() + frame.m_palette;
+
+		//interlaced frames store rows in four passes
+		static const int starts[4]= {0, 4, 2, 1};
+		static const int steps[4]= {8, 8, 4, 2};
+		int pass= 0, row= 0;
+		for(int i= 0; i< frame.m_height; i++){
+			int y= i;
+			if(frame.m_interlaced){
+				while(row>= frame.m_height && pass< 3){
+					pass++;
+					row= starts[pass];
+				}
+				y= row;
+				row+= steps[pass];
+			}
+			int canvas_y= frame.m_top + y;
+			if(canvas_y< 0 || canvas_y>= m_height) continue;
+
+			for(int x= 0; x< frame.m_width; x++){
+				size_t source= (size_t)i*frame.m_width + x;
+				if(source>= decoded) return;
+				int canvas_x= frame.m_left + x;
+				if(canvas_x< 0 || canvas_x>= m_width) continue;
+
+				int index= m_indices[source];
+				if(index== frame.m_transparent || index>= frame.m_palette_size) continue;
+				unsigned char *pixel= m_canvas.data() + ((size_t)canvas_y*m_width + canvas_x)*4;
+				pixel[0]= palette[index*3];
+				pixel[1]= palette[index*3 + 1];
+				pixel[2]= palette[index*3 + 2];
+				pixel[3]= 255;
+			}
+		}
+	}
+};
+
+//one decoded gif and its texture, shared by every element that shows the same file on the same frame clock
+//short loops are uploaded once into an atlas and played by moving m_source, longer ones stream a frame at a time.
+//the file is parsed and the atlas decoded on a loader thread, the texture is created once the main thread uploads it
+class Animation: public Asset{
+public:
+	GifStream m_gif;
+	Texture2D m_texture= {0};
+	Rectangle m_source= {0, 0, 0, 0};	//current frame inside m_texture
+	bool m_is_atlas= false;
+	int m_columns= 1;
+	int m_frames= 0;
+	int m_delay= 8;
+	const int *m_delay_ref= nullptr;	//live delay owned by the caller, overrides m_delay
+	int m_frame= 0;
+	int m_counter= 0;
+
+	Animation(const std::string& path, int delay, const int *delay_ref): m_delay(delay), m_delay_ref(delay_ref){
+		m_path= path;
+	}
+
+	void Decode() override{
+		if(!m_gif.Open(m_path)) return;
+		m_frames= m_gif.GetFrameCount();
+		m_source= (Rectangle){0, 0, (float)m_gif.m_width, (float)m_gif.m_height};
+		if(m_frames> 1 && DecodeAtlas()) return;
+		m_gif.Pixels();
+	}
+
+	void Upload() override{
+		m_is_ready= true;
+		m_version++;
+		if(!m_atlas.empty()){
+			Image atlas= {m_atlas.data(), m_columns*m_gif.m_width, m_atlas_rows*m_gif.m_height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+			m_texture= ui_backend->LoadTexture(atlas);
+			std::vector<unsigned char>().swap(m_atlas);
+			if(m_texture.id!= 0){
+				m_is_atlas= true;
+				m_gif.Close();
+				return;
+			}
+			m_columns= 1;
+		}
+		if(!m_gif.IsReady()) return;
+		Image frame= {(void*)m_gif.Pixels(), m_gif.m_width, m_gif.m_height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+		m_texture= ui_backend->LoadTexture(frame);
+	}
+
+	~Animation(){
+		if(m_texture.id> 0) ui_backend->UnloadTexture(m_texture);
+	}
+
+	Animation(const Animation&)= delete;
+	Animation& operator=(const Animation&)= delete;
+
+	//0 until the animation is uploaded
+	int GetFrameCount() const{ return m_is_ready ? m_frames : 0; }
+
+	void Tick(){
+		if(m_texture.id== 0 || m_frames< 2) return;
+		m_counter++;
+		if(m_counter>= (m_delay_ref ? *m_delay_ref : m_delay)){
+			m_frame++;
+			if(m_frame>= m_frames) m_frame= 0;
+			if(m_is_atlas){
+				m_source.x= (float)((m_frame % m_columns)*m_gif.m_width);
+				m_source.y= (float)((m_frame / m_columns)*m_gif.m_height);
+			}
+			else{
+				ui_backend->UpdateTexture(m_texture, m_gif.Next());
+			}
+			m_counter= 0;
+			m_version++;
+		}
+	}
+
+private:
+	std::vector<unsigned char> m_atlas;		//decoded frames waiting for the upload
+	int m_atlas_rows= 0;
+
+	//decodes every frame into a grid once, false when it would break the memory or size limit
+	bool DecodeAtlas(){
+		int width= m_gif.m_width, height= m_gif.m_height;
+		size_t bytes= (size_t)width*height*4*m_frames;
+		if(bytes> ui_atlas_memory_limit || width> ui_atlas_max_size || height> ui_atlas_max_size) return false;
+
+		int columns= std::min(m_frames, ui_atlas_max_size/width);
+		int rows= (m_frames + columns - 1)/columns;
+		if(rows*height> ui_atlas_max_size) return false;
+
+		size_t stride= (size_t)columns*width*4;
+		m_atlas.assign(stride*rows*height, 0);
+		for(int i= 0; i< m_frames; i++){
+			const unsigned char *frame= m_gif.Next();
+			unsigned char *dest= m_atlas.data() + (size_t)(i / columns)*height*stride + (size_t)(i % columns)*width*4;
+			for(int y= 0; y< height; y++){
+				std::copy(frame + (size_t)y*width*4, frame + (size_t)(y + 1)*width*4, dest + y*stride);
+			}
+		}
+		m_columns= columns;
+		m_atlas_rows= rows;
+		return true;
+	}
+};
+
+//hands out shared animations keyed by path and frame clock, an animation lives as long as someone holds it
+class AnimationCache{
+public:
+	static AnimationCache& Get(){
+		static AnimationCache cache;
+		return cache;
+	}
+
+	std::shared_ptr<Animation> Acquire(const std::string& path, int delay, const int *delay_ref= nullptr){
+		Key key= {path, delay_ref ? 0 : delay, delay_ref};
+		auto it= m_animations.find(key);
+		if(it!= m_animations.end()){
+			if(auto animation= it->second.lock()) return animation;
+		}
+		auto animation= std::make_shared<Animation>(path, delay, delay_ref);
+		m_animations[key]= animation;
+		AssetLoader::Get().Load(animation);
+		return animation;
+	}
+
+	//advances every live animation once, however many elements show it
+	void Tick(){
+		for(auto it= m_animations.begin(); it!= m_animations.end();){
+			if(auto animation= it->second.lock()){
+				animation->Tick();
+				++it;
+			}
+			else{
+				it= m_animations.erase(it);
+			}
+		}
+	}
+
+	size_t GetCount() const{ return m_animations.size(); }
+
+private:
+	struct Key{
+		std::string m_path;
+		int m_delay;
+		const int *m_delay_ref;
+
+		bool operator==(const Key& other) const{
+			return m_delay== other.m_delay && m_delay_ref== other.m_delay_ref && m_path== other.m_path;
+		}
+	};
+
+	struct KeyHash{
+		size_t operator()(const Key& key) const{
+			size_t h= std::hash<std::string>()(key.m_path);
+			h^= std::hash<int>()(key.m_delay) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			h^= std::hash<const void*>()(key.m_delay_ref) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			return h;
+		}
+	};
+
+	std::unordered_map<Key, std::weak_ptr<Animation>, KeyHash> m_animations;
+};
+
+class ThumbnailGif: public GuiElement{
+public:
+	std::shared_ptr<Animation> m_animation;
+	std::function<void()> m_call_back_function;
+	std::string m_text_button;
+	CachedText m_button_label;
+	std::string m_gif_path;
+	int m_frames= 0;
+	int m_current_frame= 0;
+	int m_frame_delay= 8;
+	unsigned int m_drawn_version= 0;
+
+	ThumbnailGif(std::string text, const std::string& gif_path, std::function<void()> call_back_function, std::string text_button, int frame_delay= 8){
+		m_text= text;
+		m_gif_path= gif_path;
+		m_call_back_function= call_back_function;
+		m_text_button= text_button;
+		m_frame_delay= frame_delay;
+
+		m_animation= AnimationCache::Get().Acquire(m_gif_path, m_frame_delay);
+	}
+
+	float MeasureHeight(float width) override{
+		return font_size *2 + element_padding;
+	}
+
+	void Update() override{
+		if(IsMouseOver() && ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			if(m_call_back_function){
+				m_call_back_function();
+			}
+		}
+	}
+
+	//frames are advanced by the cache, this only notices that the shared texture changed
+	bool CheckDirty() override{
+		if(m_animation->m_version!= m_drawn_version){
+			m_drawn_version= m_animation->m_version;
+			m_current_frame= m_animation->m_frame;
+			m_frames= m_animation->GetFrameCount();
+			m_is_dirty= true;
+		}
+		return GuiElement::CheckDirty();
+	}
+
+	bool IsAnimating() const override{ return !m_animation->IsReady() || m_frames> 1; }
+
+	void Draw() override{		Color currentColor= IsMouseOver() ? 
+			(ui_input.IsPressed(MOUSE_BUTTON_LEFT) ? ui_element_click : ui_element_hover) : ui_element_body;
+		// DrawRectangle(static_cast<int>(m_position.x + thumnnail_size + element_padding), static_cast<int>(m_position.y + m_size.y/2),
+		// 			  static_cast<int>(m_size.x - thumnnail_size - element_padding), static_cast<int>(m_size.y/2), currentColor);
+
+		Rectangle rec= {static_cast<float>(m_position.x + thumnnail_size + element_padding), static_cast<float>(m_position.y + m_size.y/2),
+					static_cast<float>(m_size.x - thumnnail_size - element_padding), static_cast<float>(m_size.y/2)};
+		ui_draw_list->AddRectRounded(rec, 0.3f, 2, currentColor);
+
+
+		const TextRun& button_label= m_button_label.Get(m_font, m_text_button);
+		Vector2 pos= {(float)static_cast<int>(m_position.x + thumnnail_size + element_padding + (m_size.x - thumnnail_size - element_padding)/2 - button_label.m_size.x/2),
+					(float)static_cast<int>(m_position.y + 3*(m_size.y/4) - font_size/2.5)};
+		DrawTextRun(m_font, button_label, pos, ui_text_light);
+
+		const Rectangle& frame= m_animation->m_source;
+		if(m_animation->m_texture.id== 0){
+			DrawPlaceholder((Rectangle){m_position.x, m_position.y, thumnnail_size, thumnnail_size});
+		}
+		else{
+			float scale= (frame.width> frame.height) ? thumnnail_size/frame.width : thumnnail_size/frame.height;
+			ui_draw_list->AddTexture(m_animation->m_texture, frame, (Rectangle){m_position.x, m_position.y, frame.width*scale, frame.height*scale}, WHITE);
+		}
+
+		Vector2 pos2= {(float)static_cast<int>(m_position.x +thumnnail_size +element_padding), (float)static_cast<int>(m_position.y +m_size.y/4 -font_size/2.5)};
+		DrawTextRun(m_font, m_label.Get(m_font, m_text), pos2, ui_text_light);
+	}
+};
+
+class Billboard: public GuiElement{
+public:
+	Texture2D *m_texture;
+	std::shared_ptr<TextureAsset> m_asset;	//set when the billboard loads its own image
+	unsigned int m_drawn_version= 0;
+
+	Billboard(Texture2D &texture){
+		m_texture= &texture;
+	}
+
+	//loads the image in the background, a placeholder is drawn until it is there
+	Billboard(const std::string& path){
+		m_asset= AssetLoader::Get().AcquireTexture(path);
+		m_texture= &m_asset->m_texture;
+	}
+
+	~Billboard(){
+		if(!m_asset) ui_backend->UnloadTexture(*m_texture);
+	}
+
+	float MeasureHeight(float width) override{
+		return width;
+	}
+	bool HeightDependsOnWidth() const override{ return true; }
+
+	void Update() override{}
+
+	bool IsAnimating() const override{ return m_asset && !m_asset->IsReady(); }
+
+	bool CheckDirty() override{
+		if(m_asset && m_asset->m_version!= m_drawn_version){
+			m_drawn_version= m_asset->m_version;
+			m_is_dirty= true;
+		}
+		return GuiElement::CheckDirty();
+	}
+
+	void Draw() override{
+		if(m_texture->id== 0){
+			DrawPlaceholder((Rectangle){m_position.x, m_position.y, m_size.x, m_size.x});
+			return;
+		}
+		float scale= (m_texture->width> m_texture->height) ? (float)m_size.x/(m_texture->width) : (float)m_size.x/(m_texture->height);
+		ui_draw_list->AddTextureEx(*m_texture, m_position, scale, WHITE);
+	}
+};
+
+class BillboardGif: public GuiElement{
+public:
+	std::shared_ptr<Animation> m_animation;
+	int m_frames= 0;
+	int m_current_frame= 0;
+	int *m_frame_delay;
+	unsigned int m_drawn_version= 0;
+	std::string m_gif_path;
+
+	BillboardGif(const std::string& gif_path, int &frame_delay){
+		m_gif_path= gif_path;
+		m_frame_delay= &frame_delay;
+		m_animation= AnimationCache::Get().Acquire(m_gif_path, frame_delay, m_frame_delay);
+	}
+
+	float MeasureHeight(float width) override{
+		return width;
+	}
+	bool HeightDependsOnWidth() const override{ return true; }
+
+	void Update() override{}
+
+	bool CheckDirty() override{
+		if(m_animation->m_version!= m_drawn_version){
+			m_drawn_version= m_animation->m_version;
+			m_current_frame= m_animation->m_frame;
+			m_frames= m_animation->GetFrameCount();
+			m_is_dirty= true;
+		}
+		return GuiElement::CheckDirty();
+	}
+
+	bool IsAnimating() const override{ return !m_animation->IsReady() || m_frames> 1; }
+
+	void Draw() override{
+		const Rectangle& frame= m_animation->m_source;
+		if(m_animation->m_texture.id== 0){
+			DrawPlaceholder((Rectangle){m_position.x, m_position.y, m_size.x, m_size.x});
+			return;
+		}
+		float scale= (frame.width> frame.height) ? m_size.x/frame.width : m_size.x/frame.height;
+		ui_draw_list->AddTexture(m_animation->m_texture, frame, (Rectangle){m_position.x, m_position.y, frame.width*scale, frame.height*scale}, WHITE);
+	}
+};
+
+//shared by the 3D views, renders the user's scene into a texture that the panel blits
+//the render policy decides when that texture is refreshed, idle views keep showing the last one
+//the texture can be smaller than the view (m_render_scale) and is stretched when blitted
+class CameraView: public GuiElement{
+public:
+	enum RenderPolicy{
+		RENDER_ALWAYS,				//every frame the view is visible
+		RENDER_ON_CAMERA_CHANGE,	//when the camera moved or Invalidate() was called
+		RENDER_ON_INVALIDATE,		//only after Invalidate()
+		RENDER_CAPPED				//every frame but at most m_max_rate times per second
+	};
+
+	Camera3D *m_camera;
+	RenderTexture m_render_texture= {0};
+	Color m_color;
+	std::function<void(Camera3D&)> m_draw_scene_function;
+	bool m_update_camera= false;
+	int m_render_policy= RENDER_ALWAYS;
+	float m_max_rate= 30.0f;
+	bool m_is_invalid= true;
+	Camera3D m_drawn_camera= {0};
+	double m_last_render= 0.0;
+
+	Vector2 m_target_size= {0, 0};	//size the texture is shown at, before scaling
+	float m_render_scale= 1.0f;
+	bool m_adaptive_scale= false;
+	float m_target_rate= 60.0f;		//frame rate adaptive scaling tries to hold
+	float m_min_scale= 0.25f;
+	float m_frame_time= 0.0f;		//smoothed frame time adaptive scaling reacts to
+	double m_last_adapt= 0.0;
+
+	CameraView(Camera3D &camera, std::function<void(Camera3D&)> draw_scene_function, Color color){
+		m_camera= &camera;
+		m_draw_scene_function= draw_scene_function;
+		m_color= color;
+	}
+
+	virtual ~CameraView(){
+		if(m_render_texture.id> 0) ui_backend->UnloadRenderTarget(m_render_texture);
+	}
+
+	void SetRenderPolicy(int policy, float max_rate= 30.0f){
+		m_render_policy= policy;
+		m_max_rate= max_rate;
+		m_is_invalid= true;
+	}
+
+	//the scene changed, render it again the next time the view is drawn
+	void Invalidate(){ m_is_invalid= true; }
+
+	//renders at a fraction of the view size, 0.5 shades a quarter of the pixels
+	void SetRenderScale(float scale){
+		m_render_scale= std::clamp(scale, 0.05f, 1.0f);
+		m_adaptive_scale= false;
+	}
+
+	//lowers the render scale in steps while frames take longer than 1/target_rate and raises it again when there is headroom
+	void SetAdaptiveScale(bool enabled, float target_rate= 60.0f, float min_scale= 0.25f){
+		m_adaptive_scale= enabled;
+		m_target_rate= target_rate;
+		m_min_scale= std::clamp(min_scale, 0.05f, 1.0f);
+		m_frame_time= 0.0f;
+	}
+
+	//the view flies the camera while it has the focus
+	void Update() override{
+		if(IsMouseOver() && ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			ui_focus.SetFocus(this);
+		}
+		else if(ui_input.IsKeyPressed(KEY_ESCAPE)){
+			ui_focus.ClearFocus(this);
+		}
+
+		if(m_update_camera){
+			ui_backend->UpdateCamera(*m_camera);
+		}
+	}
+
+	void FocusChanged(bool is_focused) override{
+		m_update_camera= is_focused;
+		if(is_focused) ui_backend->DisableCursor();
+		else ui_backend->EnableCursor();
+	}
+
+	//a flown camera or a view that renders on its own keeps frames coming, the others wait for input or Invalidate()
+	bool IsAnimating() const override{
+		return m_update_camera || m_is_invalid || m_render_policy== RENDER_ALWAYS || m_render_policy== RENDER_CAPPED;
+	}
+
+	bool NeedsRender() const{
+		if(m_is_invalid) return true;
+		switch(m_render_policy){
+			case RENDER_ALWAYS: return true;
+			case RENDER_ON_CAMERA_CHANGE: return CameraMoved();
+			case RENDER_CAPPED: return m_max_rate<= 0.0f || ui_backend->GetTime() - m_last_render>= 1.0/m_max_rate;
+			default: return false;
+		}
+	}
+
+	//sizing runs here rather than in Update(), which only gets called when there is input for the view
+	void DrawOffscreen() override{
+		if(m_adaptive_scale) AdaptScale();
+		UpdateTarget();
+		if(m_render_texture.id== 0 || !NeedsRender()) return;
+
+		ui_backend->RenderScene(m_render_texture, *m_camera, m_color, m_draw_scene_function);
+
+		m_drawn_camera= *m_camera;
+		m_last_render= ui_backend->GetTime();
+		m_is_invalid= false;
+		m_is_dirty= true;
+	}
+
+	void Draw() override{
+		Rectangle sourceRec= {0.0f, 0.0f, (float)m_render_texture.texture.width, (float)-m_render_texture.texture.height};
+		Rectangle dest= {m_position.x, m_position.y, (float)static_cast<int>(m_target_size.x), (float)static_cast<int>(m_target_size.y)};
+		ui_draw_list->AddTexture(m_render_texture.texture, sourceRec, dest, WHITE);
+	}
+
+	RenderTexture& GetRenderTexture(){
+		return m_render_texture;
+	}
+
+protected:
+	virtual Vector2 TargetSize()= 0;
+
+	//(re)allocates the texture when the element was resized or the render scale changed
+	void UpdateTarget(){
+		m_target_size= TargetSize();
+		int width= std::max(1, static_cast<int>(m_target_size.x*m_render_scale));
+		int height= std::max(1, static_cast<int>(m_target_size.y*m_render_scale));
+		if(m_render_texture.id> 0 && m_render_texture.texture.width== width && m_render_texture.texture.height== height) return;
+
+		if(m_render_texture.id> 0) ui_backend->UnloadRenderTarget(m_render_texture);
+		m_render_texture= ui_backend->LoadRenderTarget(width, height);
+		ui_backend->SetTextureFilter(m_render_texture.texture, (m_render_scale< 1.0f) ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
+		m_is_invalid= true;
+		m_is_dirty= true;
+	}
+
+	void AdaptScale(){
+		float frame_time= ui_backend->GetFrameTime();
+		m_frame_time= (m_frame_time<= 0.0f) ? frame_time : m_frame_time*0.9f + frame_time*0.1f;
+
+		//one step at a time and not too often, every step reallocates the texture
+		double now= ui_backend->GetTime();
+		if(now - m_last_adapt< 0.5 || m_target_rate<= 0.0f) return;
+		float budget= 1.0f/m_target_rate;
+		if(m_frame_time> budget*1.1f && m_render_scale> m_min_scale){
+			m_render_scale= std::max(m_min_scale, m_render_scale - 0.125f);
+			m_last_adapt= now;
+		}
+		else if(m_frame_time< budget*0.75f && m_render_scale< 1.0f){
+			m_render_scale= std::min(1.0f, m_render_scale + 0.125f);
+			m_last_adapt= now;
+		}
+	}
+
+	bool CameraMoved() const{
+		const Camera3D& a= *m_camera;
+		const Camera3D& b= m_drawn_camera;
+		return a.position.x!= b.position.x || a.position.y!= b.position.y || a.position.z!= b.position.z ||
+			   a.target.x!= b.target.x || a.target.y!= b.target.y || a.target.z!= b.target.z ||
+			   a.up.x!= b.up.x || a.up.y!= b.up.y || a.up.z!= b.up.z ||
+			   a.fovy!= b.fovy || a.projection!= b.projection;
+	}
+};
+
+class CameraView3D : public CameraView{
+public:
+	int m_width= 0;
+
+	CameraView3D(Camera3D &camera, std::function<void(Camera3D&)> draw_scene_function, Color background_color)
+		: CameraView(camera, draw_scene_function, background_color){}
+
+	float MeasureHeight(float width) override{
+		return width;
+	}
+	bool HeightDependsOnWidth() const override{ return true; }
+
+protected:
+	Vector2 TargetSize() override{
+		m_width= m_size.x;
+		return (Vector2){(float)m_width, (float)m_width};
+	}
+};
+
+class CameraView3DFill : public CameraView{
+public:
+	CameraView3DFill(Camera3D &camera, std::function<void(Camera3D&)> draw_scene_function, Color color)
+		: CameraView(camera, draw_scene_function, color){}
+
+	bool FillsPanel() const override{ return true; }
+	//reaches the panel's edges, CameraView3DFillBorder keeps the padding
+	bool SpansColumn() const override{ return true; }
+
+protected:
+	Vector2 TargetSize() override{
+		return m_size;
+	}
+};
+
+class CameraView3DFillBorder : public CameraView{
+public:
+	CameraView3DFillBorder(Camera3D &camera, std::function<void(Camera3D&)> draw_scene_function, Color color)
+		: CameraView(camera, draw_scene_function, color){}
+
+	bool FillsPanel() const override{ return true; }
+
+protected:
+	Vector2 TargetSize() override{
+		return m_size;
+	}
+};
+
+class ColorPicker: public GuiElement{
+public:
+	Binding<Color> m_target;
+	Color m_color= {0, 0, 0, 0};
+	int m_r= 255;
+	int m_g= 0;
+	int m_b= 0;
+	int m_a= 255;
+
+	bool m_calculated= false;
+	Color m_drawn_color= {0, 0, 0, 0};
+	int m_drawn_active= -1;
+
+	Vector2 m_slider_size= {m_size.x/4, font_size};
+	Vector2 m_pos_r= {m_position.x + (m_size.x/4)*3, m_position.y + font_size + element_padding};
+	Vector2 m_pos_g= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*2 + element_padding*2};
+	Vector2 m_pos_b= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*3 + element_padding*3};
+	Vector2 m_pos_a= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*4 + element_padding*4};
+
+	bool m_is_active_r= false;
+	bool m_is_active_g= false;
+	bool m_is_active_b= false;
+	bool m_is_active_a= false;
+
+	Rectangle m_rec_r= {m_pos_r.x, m_pos_r.y, m_slider_size.x, m_slider_size.y};
+	Rectangle m_rec_g= {m_pos_g.x, m_pos_g.y, m_slider_size.x, m_slider_size.y};
+	Rectangle m_rec_b= {m_pos_b.x, m_pos_b.y, m_slider_size.x, m_slider_size.y};
+	Rectangle m_rec_a= {m_pos_a.x, m_pos_a.y, m_slider_size.x, m_slider_size.y};
+
+
+	ColorPicker(std::string text, Binding<Color> color): m_target(color){
+		m_text= text;
+		SyncChannels();
+	}
+
+	void CompleteCalculation(){
+		m_slider_size= {m_size.x/4, font_size};
+		m_pos_r= {m_position.x + (m_size.x/4)*3, m_position.y + font_size + element_padding};
+		m_pos_g= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*2 + element_padding*2};
+		m_pos_b= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*3 + element_padding*3};
+		m_pos_a= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*4 + element_padding*4};
+
+		m_rec_r= {m_pos_r.x, m_pos_r.y, m_slider_size.x, m_slider_size.y};
+		m_rec_g= {m_pos_g.x, m_pos_g.y, m_slider_size.x, m_slider_size.y};
+		m_rec_b= {m_pos_b.x, m_pos_b.y, m_slider_size.x, m_slider_size.y};
+		m_rec_a= {m_pos_a.x, m_pos_a.y, m_slider_size.x, m_slider_size.y};
+	}
+
+	float MeasureHeight(float width) override{
+		return (font_size + element_padding) *5;
+	}
+
+	void Update() override{
+		if(!m_calculated) CompleteCalculation();
+		SyncChannels();
+
+		if(ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			bool is_over_r= IsMouseOverEx(m_pos_r, m_slider_size);
+			bool is_over_g= IsMouseOverEx(m_pos_g, m_slider_size);
+			bool is_over_b= IsMouseOverEx(m_pos_b, m_slider_size);
+			bool is_over_a= IsMouseOverEx(m_pos_a, m_slider_size);
+			if(is_over_r || is_over_g || is_over_b || is_over_a){
+				m_is_active_r= is_over_r;
+				m_is_active_g= is_over_g;
+				m_is_active_b= is_over_b;
+				m_is_active_a= is_over_a;
+				ui_focus.SetFocus(this);
+			}
+		}
+		else if(ui_input.IsKeyPressed(KEY_ESCAPE) || ui_input.IsKeyPressed(KEY_ENTER)){
+			ui_focus.ClearFocus(this);
+		}
+
+		updateSlider(&m_r, IsMouseOverEx(m_pos_r, m_slider_size), m_is_active_r, 1, 0, 255, 3);
+		updateSlider(&m_g, IsMouseOverEx(m_pos_g, m_slider_size), m_is_active_g, 1, 0, 255, 3);
+		updateSlider(&m_b, IsMouseOverEx(m_pos_b, m_slider_size), m_is_active_b, 1, 0, 255, 3);
+		updateSlider(&m_a, IsMouseOverEx(m_pos_a, m_slider_size), m_is_active_a, 1, 0, 255, 3);
+
+		//only an edit is written back, the bound color is not touched every frame
+		Color color= {(unsigned char)m_r, (unsigned char)m_g, (unsigned char)m_b, (unsigned char)m_a};
+		if(color.r!= m_color.r || color.g!= m_color.g || color.b!= m_color.b || color.a!= m_color.a){
+			m_color= color;
+			m_target.Store(m_color);
+		}
+	}
+
+	void FocusChanged(bool is_focused) override{
+		if(is_focused) return;
+		m_is_active_r= false;
+		m_is_active_g= false;
+		m_is_active_b= false;
+		m_is_active_a= false;
+	}
+
+	bool CheckDirty() override{
+		SyncChannels();
+		int active= m_is_active_r | (m_is_active_g << 1) | (m_is_active_b << 2) | (m_is_active_a << 3);
+		if(m_color.r!= m_drawn_color.r || m_color.g!= m_drawn_color.g || m_color.b!= m_drawn_color.b || m_color.a!= m_drawn_color.a || active!= m_drawn_active){
+			m_drawn_color= m_color;
+			m_drawn_active= active;
+			m_is_dirty= true;
+		}
+		return GuiElement::CheckDirty();
+	}
+
+	void Draw() override{
+		//the channel rects follow the element, which moves without an Update() while scrolling
+		if(!m_calculated) CompleteCalculation();
+		Rectangle gradient= {(float)static_cast<int>(m_position.x), (float)static_cast<int>(m_position.y), (float)static_cast<int>(m_size.x/2- element_padding*3), (float)static_cast<int>(m_size.y)};
+		ui_draw_list->AddRectGradientH(gradient, WHITE, m_color);
+		ui_draw_list->AddRectGradientV(gradient, (Color){0, 0, 0, 0}, BLACK);
+
+		const TextRun& label= m_label.Get(m_font, m_text);
+		Vector2 pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/4)*3 - label.m_size.x/2), (float)static_cast<int>(m_position.y + m_slider_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, label, pos_text, ui_text_light);
+
+		DrawChannel(0, m_rec_r, m_is_active_r, m_r);
+		DrawChannel(1, m_rec_g, m_is_active_g, m_g);
+		DrawChannel(2, m_rec_b, m_is_active_b, m_b);
+		DrawChannel(3, m_rec_a, m_is_active_a, m_a);
+	}
+
+private:
+	CachedText m_channel_labels[4];
+	CachedText m_value_labels[4];
+
+	void SyncChannels(){
+		if(!m_target.IsSettled()) return;
+		m_color= m_target.Load();
+		m_r= m_color.r;
+		m_g= m_color.g;
+		m_b= m_color.b;
+		m_a= m_color.a;
+	}
+
+	void DrawChannel(int channel, const Rectangle& rec, bool is_active, int value){
+		static const std::string names[4]= {"R", "G", "B", "A"};
+		ui_draw_list->AddRectRounded(rec, 0.3f, 2, (is_active) ? ui_element_hover : ui_element_body);
+
+		const TextRun& name= m_channel_labels[channel].Get(m_font, names[channel]);
+		Vector2 pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/8)*5 - name.m_size.x/2), (float)static_cast<int>(rec.y + m_slider_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, name, pos_text, ui_text_light);
+
+		ValueBuffer buffer;
+		const TextRun& number= m_value_labels[channel].Get(m_font, format_int(buffer, value));
+		pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/8)*7 - number.m_size.x/2), (float)static_cast<int>(rec.y + m_slider_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, number, pos_text, ui_text_light);
+	}
+};
+
+//stores elements by type in fixed size chunks, so a big panel is a few allocations instead of one per element.
+//addresses never move, so the pointers handed out stay valid for the arena's whole life
+class ElementArena{
+public:
+	static constexpr size_t chunk_size= 256;
+
+	ElementArena(){}
+	ElementArena(const ElementArena&)= delete;
+	ElementArena& operator=(const ElementArena&)= delete;
+
+	~ElementArena(){
+		//pools are indexed by TypeIndex<T>(), so this is not creation order: types go in reverse order of their first use
+		//anywhere in the program and each pool destroys its own elements newest first. element destructors must not
+		//reach other elements of the same arena
+		for(auto it= m_pools.rbegin(); it!= m_pools.rend(); ++it) it->reset();
+	}
+
+	template <typename T, typename... Args>
+	T* Create(Args&&... args){
+		Pool<T>& pool= GetPool<T>();
+		if(pool.m_count== pool.m_chunks.size()*chunk_size){
+			pool.m_chunks.emplace_back(new Slot<T>[chunk_size]);
+		}
+		T *element= new (pool.m_chunks[pool.m_count/chunk_size][pool.m_count%chunk_size].m_bytes) T(std::forward<Args>(args)...);
+		pool.m_count++;
+		return element;
+	}
+
+	//allocates the chunks for count more elements of a type up front
+	template <typename T>
+	void Reserve(size_t count){
+		Pool<T>& pool= GetPool<T>();
+		size_t needed= (pool.m_count + count + chunk_size - 1)/chunk_size;
+		pool.m_chunks.reserve(needed);
+		while(pool.m_chunks.size()< needed) pool.m_chunks.emplace_back(new Slot<T>[chunk_size]);
+	}
+
+	size_t GetElementCount() const{
+		size_t count= 0;
+		for(const auto& pool : m_pools){
+			if(pool) count+= pool->m_count;
+		}
+		return count;
+	}
+
+	size_t GetMemoryUsage() const{
+		size_t bytes= 0;
+		for(const auto& pool : m_pools){
+			if(pool) bytes+= pool->m_chunk_bytes*pool->ChunkCount();
+		}
+		return bytes;
+	}
+
+private:
+	template <typename T>
+	struct alignas(T) Slot{
+		unsigned char m_bytes[sizeof(T)];
+	};
+
+	struct PoolBase{
+		size_t m_count= 0;
+		size_t m_chunk_bytes= 0;
+		virtual ~PoolBase(){}
+		virtual size_t ChunkCount() const= 0;
+	};
+
+	template <typename T>
+	struct Pool: PoolBase{
+		std::vector<std::unique_ptr<Slot<T>[]>> m_chunks;
+
+		Pool(){ m_chunk_bytes= sizeof(Slot<T>)*chunk_size; }
+		~Pool(){
+			for(size_t i= m_count; i> 0; i--){
+				reinterpret_cast<T*>(m_chunks[(i - 1)/chunk_size][(i - 1)%chunk_size].m_bytes)->~T();
+			}
+		}
+		size_t ChunkCount() const override{ return m_chunks.size(); }
+	};
+
+	//every element type gets a small index the first time it is stored, pools are looked up by it
+	static inline int s_type_count= 0;
+	template <typename T>
+	static int TypeIndex(){
+		static int index= s_type_count++;
+		return index;
+	}
+
+	template <typename T>
+	Pool<T>& GetPool(){
+		int index= TypeIndex<T>();
+		if(index>= (int)m_pools.size()) m_pools.resize(index + 1);
+		if(!m_pools[index]) m_pools[index]= std::make_unique<Pool<T>>();
+		return static_cast<Pool<T>&>(*m_pools[index]);
+	}
+
+	std::vector<std::unique_ptr<PoolBase>> m_pools;
+};
+
+class Panel: public GuiElement{//_____________________________________________________________________ PANEL ________________________________________________________________________________//
+public:
+	std::vector<std::shared_ptr<GuiElement>> m_elements;
+	Font m_custom_font= ui_backend->GetDefaultFont();
+	int m_header_size= font_size;
+	bool m_is_minimized= false;
+	bool m_is_moving= false;
+	int m_grid_size= grid_size;
+	int m_sections= 1;
+	bool m_has_header= true;
+	int m_counter= 0;
+	bool m_use_cache= true;
+	RenderTexture m_cache= {0};
+	DrawList m_draw_list;		//records the cache contents while rasterizing
+	std::shared_ptr<ElementArena> m_arena;	//backs emplaceElement, created on first use
+
+	//panels scroll by a pixel offset that eases towards m_scroll_target, rows cut by the edges are clipped.
+	//virtualized panels only touch the rows inside the visible window
+	bool m_is_virtual= false;
+	float m_scroll_offset= 0.0f;
+	float m_scroll_target= 0.0f;
+	bool m_window_dirty= true;
+	std::vector<GuiElement*> m_window;
+	std::vector<std::vector<float>> m_row_tops;	//per section, top of every row relative to the content start followed by the end
+
+	//layout is cached: m_heights holds the measured height of every element and Layout() only re-flows from m_layout_from on
+	std::vector<float> m_heights;		//-1 until measured
+	int m_layout_from= 0;				//first element whose row is stale, INT_MAX when everything is laid out
+	Vector2 m_laid_out_size= {-1, -1};
+	int m_first_fill= INT_MAX;			//first element that fills the panel, the only thing a new height moves
+	Vector2 m_laid_out_position= {0, 0};
+	float m_laid_out_scroll= 0.0f;
+	//a new width only re-measures these and bumps m_place_version, other elements get their new x and width in
+	//PlaceInColumn() once they are in view again
+	std::vector<int> m_width_dependent;	//indices of elements whose height depends on the width, ascending
+	unsigned int m_place_version= 1;
+
+	//nesting: a panel added to another panel is laid out like any element and draws into its parent's cache
+	bool m_fit_contents= false;			//takes the height of its rows instead of a fixed one, see Group
+	bool m_is_collapsible= true;		//clicking the header minimizes it
+	bool m_is_measuring= false;
+
+	std::vector<GuiElement*> m_updated;		//children that asked for an Update() every frame
+	std::vector<GuiElement*> m_update_list;
+
+	Panel(std::string text, Vector2 position, Vector2 size){
+		m_text= text;
+		SetPosition( (Vector2){position.x * m_grid_size, position.y * m_grid_size} );
+		SetSize( (Vector2){size.x * m_grid_size, size.y * m_grid_size} );
+	}
+
+	Panel(std::string text, Vector2 position, Vector2 size, Font custom_font){
+		m_text= text;
+		SetPosition( (Vector2){position.x * m_grid_size, position.y * m_grid_size} );
+		SetSize( (Vector2){size.x * m_grid_size, size.y * m_grid_size} );
+		m_custom_font= custom_font;
+	}
+
+	Panel(std::string text, Vector2 position, Vector2 size, int sections, Font custom_font){
+		m_text= text;
+		SetPosition( (Vector2){position.x * m_grid_size, position.y * m_grid_size} );
+		SetSize( (Vector2){size.x * m_grid_size, size.y * m_grid_size} );
+		m_sections= sections;
+		m_custom_font= custom_font;
+	}
+
+	Panel(std::string text, Vector2 position, Vector2 size, bool has_header, int sections, Font custom_font){
+		m_text= text;
+		SetPosition( (Vector2){position.x * m_grid_size, position.y * m_grid_size} );
+		SetSize( (Vector2){size.x * m_grid_size, size.y * m_grid_size} );
+		m_has_header= has_header;
+		m_sections= sections;
+		m_custom_font= custom_font;
+	}
+
+	~Panel(){
+		if(m_cache.id> 0) ui_backend->UnloadRenderTarget(m_cache);
+#ifdef SWANGUI_PROFILE
+		Profiler::Get().Forget(this);
+#endif
+	}
+
+	//panels draw into a render texture and only redraw it when something inside changed
+	void SetCaching(bool use_cache){
+		m_use_cache= use_cache;
+		m_is_dirty= true;
+	}
+
+	void Update() override{
+		SWANGUI_ZONE(ZONE_PANEL_UPDATE, this);
+		Layout();
+		bool is_toggled= false;
+		if(m_has_header){
+			if(m_is_collapsible && IsMouseOverEx(m_position, (Vector2){m_size.x, (float)m_header_size}) && ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+				SetMinimized(!m_is_minimized);
+				is_toggled= true;
+			}
+			//nested panels are placed by their parent
+			if(m_parent== nullptr && m_is_moving== false && IsMouseOverEx(m_position, (Vector2){m_size.x, (float)m_header_size}) && ui_input.IsPressed(MOUSE_BUTTON_MIDDLE)){
+				m_is_moving= true;
+			}
+			else if(m_is_moving== true && (ui_input.IsKeyPressed(KEY_ESCAPE) || ui_input.IsPressed(MOUSE_BUTTON_MIDDLE))){
+				Vector2 fixedPos;
+				fixedPos.x= (int)(m_position.x / m_grid_size);
+				fixedPos.y= (int)(m_position.y / m_grid_size);
+
+				fixedPos.x= ( ((fixedPos.x *m_grid_size) -m_position.x) *(-1) < (((fixedPos.x + 1) *m_grid_size) -m_position.x )) ? fixedPos.x *m_grid_size : (fixedPos.x + 1) *m_grid_size;
+				fixedPos.y= ( ((fixedPos.y *m_grid_size) -m_position.y) *(-1) < (((fixedPos.y + 1) *m_grid_size) -m_position.y )) ? fixedPos.y *m_grid_size : (fixedPos.y + 1) *m_grid_size;
+	
+				m_position= fixedPos;
+				m_is_moving= false;
+				ui_layout_version++;
+			}
+
+			if(m_is_moving){
+				ui_layout_version++;
+				Vector2 delta= ui_input.m_delta;
+				m_position.x+= delta.x;
+				m_position.y+= delta.y;
+			}
+		}
+		//moves the elements along if the panel was dragged
+		Layout();
+
+		if(m_is_virtual && m_window_dirty) UpdateWindow();
+
+		//the click that opened the panel isn't passed on to rows scrolled under the header
+		if(m_is_minimized== false && !is_toggled) UpdateChildren();
+
+		if(m_is_minimized==false && ui_input.m_wheel!= 0 && IsScrollTarget()){
+			//a notch is a row, fractional deltas from touchpads scroll by a part of it
+			ScrollTo(m_scroll_target - ui_input.TakeWheel()*(font_size + element_padding));
+		}
+		StepScroll();
+
+		if(m_is_virtual && m_window_dirty) UpdateWindow();
+	}
+
+	//input goes down the path to the hovered and to the focused element, the other children are skipped unless
+	//they asked for updates. panels missing from the hit index (drop down menus) still update every child
+	void UpdateChildren(){
+		if(m_hit_generation== 0 || m_hit_generation!= ui_hover.m_generation){
+			ForEachCandidate([&](GuiElement& element){
+				if(IsInView(element)) UpdateChild(element);
+			});
+			return;
+		}
+
+		GuiElement *hovered= ui_input.IsIdle() ? nullptr : ChildOnPath(ui_hover.m_element);
+		GuiElement *focused= ChildOnPath(ui_focus.m_focused);
+		if(hovered && IsInView(*hovered)) UpdateChild(*hovered);
+		if(focused && focused!= hovered) UpdateChild(*focused);
+
+		//children may stop asking while they update
+		m_update_list.assign(m_updated.begin(), m_updated.end());
+		for(GuiElement *element : m_update_list){
+			if(element!= hovered && element!= focused && IsInView(*element)) UpdateChild(*element);
+		}
+	}
+
+	void UpdateChild(GuiElement& element){
+		SWANGUI_ZONE(ZONE_ELEMENT_UPDATE, &element);
+		element.Update();
+		ui_frame_stats.elements_updated++;
+	}
+
+	//the child of this panel that element is or is nested in
+	GuiElement* ChildOnPath(GuiElement *element) const{
+		while(element && element->m_parent!= this) element= element->m_parent;
+		return element;
+	}
+
+	void ChildWantsUpdate(GuiElement *child, bool wants_update) override{
+		auto it= std::find(m_updated.begin(), m_updated.end(), child);
+		if(wants_update && it== m_updated.end()) m_updated.push_back(child);
+		else if(!wants_update && it!= m_updated.end()) m_updated.erase(it);
+		RefreshWantsUpdate();
+	}
+
+	//a nested panel needs its parent to keep updating it while a child asks for it or while it scrolls
+	void RefreshWantsUpdate(){
+		SetWantsUpdate(!m_updated.empty() || m_scroll_offset!= m_scroll_target);
+	}
+
+	//the offset eases there over the next frames unless is_instant is set
+	void ScrollTo(float offset, bool is_instant= false){
+		m_scroll_target= std::clamp(offset, 0.0f, MaxScroll());
+		if(is_instant) SetScrollOffset(m_scroll_target);
+		RefreshWantsUpdate();
+	}
+
+	void StepScroll(){
+		if(m_scroll_offset== m_scroll_target) return;
+		float distance= m_scroll_target - m_scroll_offset;
+		SetScrollOffset((std::fabs(distance)< 0.5f) ? m_scroll_target : m_scroll_offset + distance*ui_scroll_smoothing);
+		RefreshWantsUpdate();
+	}
+
+	void SetScrollOffset(float offset){
+		if(m_scroll_offset== offset) return;
+		m_scroll_offset= offset;
+		m_window_dirty= true;
+		m_is_dirty= true;
+		ui_layout_version++;
+		Layout();
+	}
+
+	float MaxScroll() const{
+		return std::max(0.0f, ContentHeight() - (m_position.y + m_size.y - ContentTop()));
+	}
+
+	float ContentTop() const{
+		return m_position.y + (m_has_header ? element_padding +font_size : element_padding);
+	}
+
+	//the body below the header, elements are clipped to it when drawn and hit tested
+	Rectangle ContentClip() const{
+		float header= m_has_header ? (float)m_header_size : 0.0f;
+		return (Rectangle){m_position.x, m_position.y + header, m_size.x, std::max(0.0f, m_size.y - header)};
+	}
+
+	bool IsContainer() const override{ return true; }
+
+	Rectangle GetBounds() const{
+		return (Rectangle){m_position.x, m_position.y, m_size.x, m_is_minimized ? (float)(m_has_header ? m_header_size : 0) : m_size.y};
+	}
+
+	void SetMinimized(bool is_minimized){
+		if(m_is_minimized== is_minimized) return;
+		m_is_minimized= is_minimized;
+		m_is_dirty= true;
+		ui_layout_version++;
+		//a collapsed child only keeps its header, the parent re-flows around it
+		if(m_parent) RequestLayout();
+	}
+
+	//a nested panel measures by laying itself out at the given width
+	bool HeightDependsOnWidth() const override{ return m_fit_contents; }
+
+	float MeasureHeight(float width) override{
+		if(m_is_minimized) return m_has_header ? (float)m_header_size : 0.0f;
+		if(!m_fit_contents) return m_size.y;
+		m_is_measuring= true;
+		m_size.x= width;
+		Layout();
+		m_is_measuring= false;
+		return FitHeight();
+	}
+
+	float FitHeight() const{
+		return (ContentTop() - m_position.y) + ContentHeight();
+	}
+
+	//the wheel goes to the innermost panel under the mouse that scrolls, groups that fit their contents pass it up
+	bool IsScrollTarget() const{
+		if(ui_hover.m_generation== 0 || m_hit_generation!= ui_hover.m_generation) return IsMouseOver();
+		const GuiElement *element= ui_hover.m_element ? ui_hover.m_element : ui_hover.m_panel;
+		while(element && !(element->IsContainer() && !static_cast<const Panel*>(element)->m_fit_contents)){
+			element= element->m_parent;
+		}
+		return element ? element== this : false;
+	}
+
+	virtual float ContentHeight() const{
+		float height= 0.0f;
+		for(const auto& tops : m_row_tops){
+			if(!tops.empty()) height= std::max(height, tops.back());
+		}
+		return height;
+	}
+
+	//elements that may be on screen, every element unless the panel is virtualized
+	//elements of regular panels that come into view after a width change are placed on the way
+	template <typename Fn>
+	void ForEachCandidate(Fn fn){
+		if(m_is_virtual){
+			for(GuiElement* element : m_window) fn(*element);
+		}
+		else{
+			for(auto& element : m_elements){
+				if(element->m_place_version!= m_place_version && IsInView(*element)) PlaceInColumn(*element);
+				fn(*element);
+			}
+		}
+	}
+
+	template <typename Fn>
+	void ForEachCandidate(Fn fn) const{
+		if(m_is_virtual){
+			for(GuiElement* element : m_window) fn(*element);
+		}
+		else{
+			for(const auto& element : m_elements) fn(*element);
+		}
+	}
+
+	//easing scroll, a drag or any child in view that animates, children of minimized panels are not drawn
+	bool IsAnimating() const override{
+		if(m_scroll_offset!= m_scroll_target || m_is_moving) return true;
+		if(m_is_minimized) return false;
+		bool is_animating= false;
+		ForEachCandidate([&](const GuiElement& element){
+			if(!is_animating && !element.m_is_hidden && IsInView(element)) is_animating= element.IsAnimating();
+		});
+		return is_animating;
+	}
+
+	void SetVirtualized(bool is_virtual){
+		m_is_virtual= is_virtual;
+		//back to the unscrolled layout either way
+		m_scroll_offset= 0.0f;
+		m_scroll_target= 0.0f;
+		m_layout_from= 0;
+		Layout();
+		m_window_dirty= true;
+		m_is_dirty= true;
+		ui_layout_version++;
+	}
+
+	//the cache is in panel space, so moving the panel only changes where it is blitted
+	void SetPosition(Vector2 pos) override{ m_position= pos; ui_layout_version++; }
+
+	//throws the cached measurements away and lays every element out again
+	void RebuildRows(){
+		std::fill(m_heights.begin(), m_heights.end(), -1.0f);
+		m_layout_from= 0;
+		Layout();
+	}
+
+	void InvalidateLayout(int index) override{
+		if(index< 0 || index>= (int)m_heights.size()) return;
+		m_heights[index]= -1.0f;
+		m_layout_from= std::min(m_layout_from, index);
+	}
+
+	//element j sits in section j%m_sections and row j/m_sections, m_row_tops holds the prefix sums of the row heights.
+	//rows before the first stale element keep their tops, so appending is O(1) and a change re-flows only what follows it.
+	//a new width re-measures the elements whose height depends on it, a new height only re-flows from the first fill element
+	//and a move only carries the elements along
+	void Layout(){
+		int count= (int)m_elements.size();
+		if((int)m_row_tops.size()!= m_sections){
+			m_row_tops.assign(m_sections, std::vector<float>(1, 0.0f));
+			for(int j : m_width_dependent) m_heights[j]= -1.0f;
+			m_layout_from= 0;
+		}
+		if(m_size.x!= m_laid_out_size.x){
+			//rows only move below an element that measures differently now, x and widths are applied lazily
+			for(int j : m_width_dependent) m_heights[j]= -1.0f;
+			if(!m_width_dependent.empty()) m_layout_from= std::min(m_layout_from, m_width_dependent.front());
+			m_place_version++;
+			m_window_dirty= true;
+			m_is_dirty= true;
+			ui_layout_version++;
+		}
+		else if(m_size.y!= m_laid_out_size.y){
+			//rows keep their place, only fill elements and the virtual window depend on the height
+			m_layout_from= std::min(m_layout_from, m_first_fill);
+			m_window_dirty= true;
+			m_is_dirty= true;
+		}
+		if(m_position.x!= m_laid_out_position.x || m_position.y!= m_laid_out_position.y){
+			MoveElements((Vector2){m_position.x - m_laid_out_position.x, m_position.y - m_laid_out_position.y});
+			m_laid_out_position= m_position;
+		}
+		m_laid_out_size= m_size;
+		//scrolling moves every row but measures nothing
+		bool is_scrolled= !m_is_virtual && m_scroll_offset!= m_laid_out_scroll;
+		if(m_layout_from== INT_MAX && !is_scrolled) return;
+		if(m_layout_from== 0) m_first_fill= INT_MAX;
+
+		float column_width= m_size.x/m_sections;
+		float content_top= ContentTop();
+		int first_row= std::min(m_layout_from, count)/m_sections;
+		for(int section= 0; section< m_sections; section++){
+			std::vector<float>& tops= m_row_tops[section];
+			tops.resize(first_row + 1);
+			for(int j= first_row*m_sections + section; j< count; j+= m_sections){
+				GuiElement& element= *m_elements[j];
+				float height= 0.0f;
+				if(element.FillsPanel()){
+					m_first_fill= std::min(m_first_fill, j);
+					height= m_size.y - (content_top + tops.back() - m_position.y) - element_padding;
+				}
+				else{
+					if(m_heights[j]< 0) m_heights[j]= (element.m_preferred_height> 0) ? element.m_preferred_height : element.MeasureHeight(ElementWidth(element, column_width));
+					height= m_heights[j];
+				}
+				float element_width= ElementWidth(element, column_width);
+				if(element.m_size.x!= element_width || element.m_size.y!= height){
+					element.m_size= (Vector2){element_width, height};
+					element.m_is_dirty= true;
+				}
+				//its x is set below, or by UpdateWindow() for virtual panels
+				element.m_place_version= m_place_version;
+				tops.push_back(tops.back() + (element.m_is_hidden ? 0.0f : height + element_padding));
+			}
+		}
+
+		//the content may have shrunk under the offset, virtual panels keep theirs since nothing is placed here
+		float max_scroll= MaxScroll();
+		if(m_scroll_target> max_scroll) m_scroll_target= max_scroll;
+		if(m_scroll_offset> max_scroll){
+			m_scroll_offset= max_scroll;
+			is_scrolled= !m_is_virtual;
+		}
+		m_laid_out_scroll= m_scroll_offset;
+
+		if(!m_is_virtual){
+			int place_from= is_scrolled ? 0 : first_row;
+			for(int section= 0; section< m_sections; section++){
+				const std::vector<float>& tops= m_row_tops[section];
+				int rows= (int)tops.size() - 1;
+				float x= m_position.x + section*column_width;
+				for(int row= place_from; row< rows; row++){
+					GuiElement& element= *m_elements[row*m_sections + section];
+					Vector2 position= {x + ElementInset(element), content_top + tops[row] - m_scroll_offset};
+					if(element.m_position.x!= position.x || element.m_position.y!= position.y){
+						element.m_position= position;
+						element.m_is_dirty= true;
+					}
+					element.m_is_visible= !element.m_is_hidden;
+				}
+			}
+		}
+
+		m_layout_from= INT_MAX;
+		m_window_dirty= true;
+		m_is_dirty= true;
+		ui_layout_version++;
+
+		if(m_parent && m_fit_contents && !m_is_measuring && !m_is_minimized && FitHeight()!= m_size.y) RequestLayout();
+	}
+
+	//space between the column edges and an element
+	static float ElementInset(const GuiElement& element){
+		return element.SpansColumn() ? 0.0f : (float)(element_padding*2);
+	}
+	static float ElementWidth(const GuiElement& element, float column_width){
+		return column_width - 2.0f*ElementInset(element);
+	}
+
+	//gives an element the x and width of its column, its row keeps the y
+	void PlaceInColumn(GuiElement& element){
+		float column_width= m_size.x/m_sections;
+		float x= m_position.x + (element.m_layout_index % m_sections)*column_width + ElementInset(element);
+		float width= ElementWidth(element, column_width);
+		if(element.m_position.x!= x || element.m_size.x!= width){
+			element.m_position.x= x;
+			element.m_size.x= width;
+			element.m_is_dirty= true;
+		}
+		element.m_place_version= m_place_version;
+	}
+
+	//shifts the placed elements by the distance the panel moved. they keep their place in the cache, which is only
+	//rasterized again if the move doesn't land on whole pixels the way the blit does
+	void MoveElements(Vector2 delta){
+		float old_x= m_laid_out_position.x, old_y= m_laid_out_position.y;
+		if((float)(static_cast<int>(m_position.x) - static_cast<int>(old_x))!= delta.x
+			|| (float)(static_cast<int>(m_position.y) - static_cast<int>(old_y))!= delta.y) m_is_dirty= true;
+		//virtual panels only placed their window, the rest is placed when it scrolls in
+		if(m_is_virtual){
+			for(GuiElement *element : m_window){
+				element->m_position.x+= delta.x;
+				element->m_position.y+= delta.y;
+			}
+		}
+		else{
+			for(const std::shared_ptr<GuiElement>& element : m_elements){
+				element->m_position.x+= delta.x;
+				element->m_position.y+= delta.y;
+			}
+		}
+		ui_layout_version++;
+	}
+
+	//finds the visible rows of every section with a binary search and positions only those
+	void UpdateWindow(){
+		m_window.clear();
+		float content_top= ContentTop();
+		float view_height= m_position.y + m_size.y - content_top;
+		for(int section= 0; section< (int)m_row_tops.size(); section++){
+			const std::vector<float>& tops= m_row_tops[section];
+			int rows= (int)tops.size() - 1;
+			int first= std::max(0, (int)(std::upper_bound(tops.begin(), tops.end(), m_scroll_offset) - tops.begin()) - 1);
+			for(int row= first; row< rows && tops[row]< m_scroll_offset + view_height; row++){
+				GuiElement* element= m_elements[row*m_sections + section].get();
+				if(element->m_is_hidden) continue;
+				PlaceInColumn(*element);
+				element->m_position.y= content_top + tops[row] - m_scroll_offset;
+				element->m_is_visible= true;
+				m_window.push_back(element);
+			}
+		}
+		m_window_dirty= false;
+		m_is_dirty= true;
+		ui_layout_version++;
+	}
+
+	//registers the panel and every element that can receive input this frame
+	void CollectHitRects(HitGrid& grid, int layer, unsigned int generation){
+		m_hit_generation= generation;
+		float height= m_is_minimized ? (float)m_header_size : m_size.y;
+		if(m_is_minimized && !m_has_header) return;
+		grid.Add((Rectangle){m_position.x, m_position.y, m_size.x, height}, this, layer, true);
+		if(m_is_minimized) return;
+		CollectElementRects(grid, layer, generation, ContentClip());
+	}
+
+	//children of nested panels are added after the panel itself, so they win over it in the same layer.
+	//rects are cut to what is visible through every enclosing panel, like their drawing
+	void CollectElementRects(HitGrid& grid, int layer, unsigned int generation, Rectangle clip){
+		Layout();
+		if(m_is_virtual && m_window_dirty) UpdateWindow();
+		ForEachCandidate([&](GuiElement& element){
+			if(IsInView(element)){
+				element.m_hit_generation= generation;
+				grid.Add(GetCollisionRec((Rectangle){element.m_position.x, element.m_position.y, element.m_size.x, element.m_size.y}, clip), &element, layer, false);
+				if(element.IsContainer() && !static_cast<Panel&>(element).m_is_minimized){
+					Panel& panel= static_cast<Panel&>(element);
+					panel.CollectElementRects(grid, layer, generation, GetCollisionRec(panel.ContentClip(), clip));
+				}
+			}
+		});
+	}
+
+	//anything that overlaps the content clip, rows cut by its edges included
+	bool IsInView(const GuiElement& element) const{
+		Rectangle clip= ContentClip();
+		return element.m_is_visible && (element.m_position.y + element.m_size.y)> clip.y && element.m_position.y< (clip.y + clip.height);
+	}
+
+	void Draw() override{
+		SWANGUI_ZONE(ZONE_PANEL_DRAW, this);
+		Layout();
+		if(m_is_virtual && m_window_dirty) UpdateWindow();
+		DrawScope scope(*ui_draw_list);
+		ui_draw_list->NextGroup();
+
+		if(m_parent){
+			//nested panels draw straight into whatever their parent records, the parent already called
+			//DrawOffscreen() and calls DrawOverlay() on them like on any element
+			DrawContents();
+			if(!m_is_minimized){
+				ForEachCandidate([&](GuiElement& element){
+					element.m_is_dirty= false;
+				});
+			}
+			m_is_dirty= false;
+			return;
+		}
+
+		if(m_is_minimized || !m_use_cache){
+			if(!m_is_minimized){
+				ForEachCandidate([&](GuiElement& element){
+					if(IsInView(element)) element.DrawOffscreen();
+				});
+			}
+			DrawContents();
+			ui_draw_list->NextGroup();
+			if(!m_is_minimized){
+				ForEachCandidate([&](GuiElement& element){
+					if(IsInView(element)) element.DrawOverlay();
+				});
+			}
+			m_is_dirty= true;
+			ui_frame_stats.panels_rasterized++;
+			return;
+		}
+
+		bool needs_raster= m_is_dirty;
+		ForEachCandidate([&](GuiElement& element){
+			if(IsInView(element)){
+				element.DrawOffscreen();
+				needs_raster|= element.CheckDirty();
+			}
+		});
+
+		int width= static_cast<int>(m_size.x);
+		int height= static_cast<int>(m_size.y);
+		if(m_cache.id== 0 || m_cache.texture.width!= width || m_cache.texture.height!= height){
+			if(m_cache.id> 0) ui_backend->UnloadRenderTarget(m_cache);
+			m_cache= ui_backend->LoadRenderTarget(width, height);
+			needs_raster= true;
+		}
+
+		if(needs_raster){
+			//the cache is in panel space, so moving the panel only changes where it is blitted
+			ui_backend->BeginPanelTarget(m_cache, (Vector2){(float)static_cast<int>(m_position.x), (float)static_cast<int>(m_position.y)});
+			{
+				DrawScope cache_scope(m_draw_list);
+				DrawContents();
+			}
+			ui_backend->EndPanelTarget();
+
+			ForEachCandidate([&](GuiElement& element){
+				element.m_is_dirty= false;
+			});
+			m_is_dirty= false;
+			ui_frame_stats.panels_rasterized++;
+		}
+		else{
+			ui_frame_stats.panels_blitted++;
+		}
+
+		Rectangle sourceRec= {0.0f, 0.0f, (float)m_cache.texture.width, (float)-m_cache.texture.height};
+		ui_draw_list->AddTextureRec(m_cache.texture, sourceRec, (Vector2){(float)static_cast<int>(m_position.x), (float)static_cast<int>(m_position.y)}, WHITE);
+
+		ui_draw_list->NextGroup();
+		ForEachCandidate([&](GuiElement& element){
+			if(IsInView(element)) element.DrawOverlay();
+		});
+	}
+
+	//what a parent asks of a nested panel, a collapsed one answers without looking at its children
+	bool CheckDirty() override{
+		if(m_is_minimized) return m_is_dirty;
+		Layout();
+		if(m_is_virtual && m_window_dirty) UpdateWindow();
+		bool is_dirty= m_is_dirty;
+		ForEachCandidate([&](GuiElement& element){
+			if(IsInView(element)) is_dirty|= element.CheckDirty();
+		});
+		return m_is_dirty= is_dirty;
+	}
+
+	void DrawOffscreen() override{
+		if(m_is_minimized) return;
+		Layout();
+		if(m_is_virtual && m_window_dirty) UpdateWindow();
+		ForEachCandidate([&](GuiElement& element){
+			if(IsInView(element)) element.DrawOffscreen();
+		});
+	}
+
+	void DrawOverlay() override{
+		if(m_is_minimized) return;
+		ForEachCandidate([&](GuiElement& element){
+			if(IsInView(element)) element.DrawOverlay();
+		});
+	}
+
+	void DrawContents(){
+		if(m_is_minimized== false){
+			Color tempColor= m_has_header ? ui_panel_body : ui_panel_header;
+			Rectangle body= {(float)static_cast<int>(m_position.x), (float)static_cast<int>(m_position.y), (float)static_cast<int>(m_size.x), (float)static_cast<int>(m_size.y)};
+			ui_draw_list->AddRect(body, tempColor);
+			ui_draw_list->AddRectLines(body, ui_panel_header);
+			ClipScope clip(ContentClip());
+			DrawElements();
+		}
+		if(m_has_header){
+			//the header covers elements scrolled under it, so it can't share their batches
+			ui_draw_list->NextGroup();
+			DrawHeader();
+		}
+	}
+
+	virtual void DrawHeader(){
+		ui_draw_list->AddRect((Rectangle){(float)static_cast<int>(m_position.x), (float)static_cast<int>(m_position.y), (float)static_cast<int>(m_size.x), (float)static_cast<int>(m_header_size)}, ui_panel_header);
+		Vector2 pos= { (float)static_cast<int>(m_position.x + element_padding), (float)static_cast<int>(m_position.y + m_header_size/2 - font_size/2.5)};
+		DrawTextRun(m_custom_font, m_label.Get(m_custom_font, m_text), pos, ui_text_highl);
+	}
+
+	//panels that store their elements differently draw them here
+	virtual void DrawElements(){
+		ForEachCandidate([&](GuiElement& element){
+			if(IsInView(element)){
+				SWANGUI_ZONE(ZONE_ELEMENT_DRAW, &element);
+				element.Draw();
+			}
+		});
+	}
+
+	template <typename T>
+	void addElement(std::shared_ptr<T> element){
+		static_assert(std::is_base_of<GuiElement, T>::value, "Element must derive from GuiElement");
+
+		element->SetFont(m_custom_font);
+		if constexpr (std::is_base_of<Panel, T>::value){
+			//nested panels use their parent's font
+			element->m_custom_font= m_custom_font;
+		}
+		element->m_parent= this;
+		element->m_layout_index= (int)m_elements.size();
+		if(element->m_wants_update) ChildWantsUpdate(element.get(), true);
+		m_elements.push_back(element);
+		m_heights.push_back(-1.0f);
+		if(element->HeightDependsOnWidth()) m_width_dependent.push_back(element->m_layout_index);
+		m_layout_from= std::min(m_layout_from, element->m_layout_index);
+		m_counter= (int)m_elements.size() %m_sections;
+		//only the new row is laid out, so the element has its position and size right away
+		Layout();
+	}
+
+	//builds the element in the panel's arena instead of its own heap block. the returned shared_ptr shares
+	//ownership of the whole arena, so it works anywhere a make_shared element does and keeps the memory alive.
+	//removing an arena element does not destroy it: it lives until the arena does, which is when the panel and every
+	//shared_ptr to any of its arena elements are gone
+	template <typename T, typename... Args>
+	std::shared_ptr<T> emplaceElement(Args&&... args){
+		if(!m_arena) m_arena= std::make_shared<ElementArena>();
+		std::shared_ptr<T> element(m_arena, m_arena->Create<T>(std::forward<Args>(args)...));
+		addElement(element);
+		return element;
+	}
+
+	//for building big panels in one go, sizes the arena and the element list once
+	template <typename T>
+	void reserveElements(size_t count){
+		if(!m_arena) m_arena= std::make_shared<ElementArena>();
+		m_arena->Reserve<T>(count);
+		m_elements.reserve(m_elements.size() + count);
+		for(auto& tops : m_row_tops) tops.reserve(tops.size() + count/std::max(1, m_sections) + 1);
+	}
+
+	//elements from emplaceElement() stay constructed in the arena after this, see there
+	void removeElement(std::shared_ptr<GuiElement> element){
+		auto it= std::find(m_elements.begin(), m_elements.end(), element);
+		if(it== m_elements.end()) return;
+		int index= (int)(it - m_elements.begin());
+		if(element->m_wants_update) ChildWantsUpdate(element.get(), false);
+		element->m_parent= nullptr;
+		element->m_layout_index= -1;
+		m_elements.erase(it);
+		m_heights.erase(m_heights.begin() + index);
+		for(int j= index; j< (int)m_elements.size(); j++) m_elements[j]->m_layout_index= j;
+		m_width_dependent.erase(std::remove(m_width_dependent.begin(), m_width_dependent.end(), index), m_width_dependent.end());
+		for(int& j : m_width_dependent){
+			if(j> index) j--;
+		}
+		m_counter= (int)m_elements.size() %m_sections;
+		m_window.clear();
+		//everything after it moves up a slot
+		m_layout_from= std::min(m_layout_from, index);
+		Layout();
+	}
+};
+
+//a collapsible block inside a panel, it is as tall as its rows and its header folds it away
+class Group: public Panel{
+public:
+	Group(std::string text, int sections= 1): Panel(text, (Vector2){0, 0}, (Vector2){0, 0}){
+		m_sections= sections;
+		m_fit_contents= true;
+	}
+};
+
+//pages that share one spot, the header is a row of tabs and only the selected page takes space
+class TabPanel: public Panel{
+public:
+	int m_active= 0;
+	std::vector<std::shared_ptr<Group>> m_pages;
+	std::vector<CachedText> m_tab_labels;
+
+	//a top level panel
+	TabPanel(std::string text, Vector2 position, Vector2 size): Panel(text, position, size){
+		m_is_collapsible= false;
+	}
+
+	//nested in another panel, as tall as the selected page
+	TabPanel(): Panel("", (Vector2){0, 0}, (Vector2){0, 0}){
+		m_is_collapsible= false;
+		m_fit_contents= true;
+	}
+
+	std::shared_ptr<Group> AddTab(const std::string& name, int sections= 1){
+		auto page= std::make_shared<Group>(name, sections);
+		page->m_has_header= false;
+		page->m_is_collapsible= false;
+		page->m_is_hidden= (int)m_pages.size()!= m_active;
+		addElement(page);
+		m_pages.push_back(page);
+		m_tab_labels.emplace_back();
+		return page;
+	}
+
+	void SetActiveTab(int index){
+		if(index< 0 || index>= (int)m_pages.size() || index== m_active) return;
+		if(m_active< (int)m_pages.size()) m_pages[m_active]->SetHidden(true);
+		m_pages[index]->SetHidden(false);
+		m_active= index;
+		m_is_dirty= true;
+	}
+
+	void Update() override{
+		if(!m_is_minimized && !m_pages.empty() && ui_input.IsPressed(MOUSE_BUTTON_LEFT) && IsMouseOverEx(m_position, (Vector2){m_size.x, (float)m_header_size})){
+			Vector2 mouse= (ui_hover.m_generation!= 0) ? ui_hover.m_mouse : ui_backend->GetMousePosition();
+			SetActiveTab((int)((mouse.x - m_position.x)/(m_size.x/m_pages.size())));
+		}
+		Panel::Update();
+	}
+
+	void DrawHeader() override{
+		Rectangle header= {(float)static_cast<int>(m_position.x), (float)static_cast<int>(m_position.y), (float)static_cast<int>(m_size.x), (float)static_cast<int>(m_header_size)};
+		ui_draw_list->AddRect(header, ui_panel_header);
+		if(m_pages.empty()) return;
+
+		float tab_width= m_size.x/m_pages.size();
+		for(int i= 0; i< (int)m_pages.size(); i++){
+			Rectangle tab= {(float)static_cast<int>(header.x + i*tab_width + 1), header.y + 1, (float)static_cast<int>(tab_width - 2), header.height - 2};
+			if(i== m_active) ui_draw_list->AddRectRounded(tab, 0.3f, 2, ui_element_hover);
+			const TextRun& label= m_tab_labels[i].Get(m_custom_font, m_pages[i]->m_text);
+			Vector2 pos= {(float)static_cast<int>(tab.x + tab.width/2 - label.m_size.x/2), (float)static_cast<int>(m_position.y + m_header_size/2 - font_size/2.5)};
+			DrawTextRun(m_custom_font, label, pos, (i== m_active) ? ui_text_light : ui_text_highl);
+		}
+	}
+};
+
+//might add drop right and drop left menus
+class DropDown: public GuiElement{
+public:
+	bool m_is_selected= false;
+	bool m_drawn_selected= false;
+	int m_extra_width= 0;
+	int m_element_count= 0;
+	Vector2 m_panel_pos;
+	Vector2 m_panel_size;
+	std::shared_ptr<Panel> m_panel;	//the menu, drawn as an overlay below the button while it is open
+
+	DropDown(const std::string text, int extra_width, int element_count){
+		m_text= text;
+		m_extra_width= extra_width;
+		m_element_count= element_count;
+
+		// m_panel= std::make_shared<Panel>("dropdown-panel", m_panel_pos, m_panel_size, false, 1, m_font);
+	}
+
+	Vector2 GetPanelPos(){
+		Vector2 temp;
+		temp.x= m_panel_pos.x/20.0;
+		temp.y= m_panel_pos.y/20.0;
+		return temp;
+	}
+
+	Vector2 GetPanelSize(){
+		Vector2 temp;
+		temp.x= m_panel_size.x/20.0;
+		temp.y= m_panel_size.y/20.0;
+		return temp;
+	}
+
+	void PrintDimensions(){
+		static bool did_print= false;
+		if(!did_print){
+			Vector2 pos= GetPanelPos();
+			Vector2 size= GetPanelSize();
+			std::cout<<"pos x: "<<pos.x<<std::endl;
+			std::cout<<"pos y: "<<pos.y<<std::endl;
+			std::cout<<"size x: "<<size.x<<std::endl;
+			std::cout<<"size y: "<<size.y<<std::endl;
+			did_print= true;
+		}
+		//size.y is +0.85 for each element
+	}
 
-	Thumbnail(std::string text, Texture2D &texture, std::function<void()> call_back_function, std::string text_button){
-		m_text= text;
-		m_texture= &texture;
-		m_call_back_function= call_back_function;
-		m_text_button= text_button;
+	void SetPanel(std::shared_ptr<Panel> panel){
+		m_panel= panel;
+		m_panel->m_parent= this;
 	}
 
 	void Update() override{
-		if(IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			if(m_call_back_function){
-				m_call_back_function();
+		static int is_initialized= 0;
+		if(is_initialized <10){
+			m_panel_pos.x= m_position.x;
+			m_panel_pos.y= (m_position.y +font_size +element_padding);
+			m_panel_size.x= (m_size.x +m_extra_width);
+			m_panel_size.y= (element_padding +((font_size +element_padding) *m_element_count));
+			is_initialized++;
+		}
+
+		if(ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			if(IsMouseOver()){
+				m_is_selected= !m_is_selected;
+			}
+			else if(!(m_is_selected && IsMouseOverEx(m_panel_pos, m_panel_size))){
+				m_is_selected= false;
 			}
+			//an open menu keeps getting updates, clicks outside of it have to close it
+			SetWantsUpdate(m_is_selected);
+		}
+		if(m_is_selected && m_panel){
+			m_panel->Update();
+		}
+	}
+
+	bool IsAnimating() const override{ return m_is_selected && m_panel && m_panel->IsAnimating(); }
+
+	bool CheckDirty() override{
+		if(m_is_selected!= m_drawn_selected){
+			m_drawn_selected= m_is_selected;
+			m_is_dirty= true;
 		}
+		return GuiElement::CheckDirty();
 	}
 
 	void Draw() override{
-		Color currentColor= IsMouseOver() ? (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) ? ui_element_click : ui_element_hover) : ui_element_body;
-		//DrawRectangle(static_cast<int>(m_position.x + thumnnail_size + element_padding), static_cast<int>(m_position.y +m_size.y/2),
-		//			  static_cast<int>(m_size.x - thumnnail_size - element_padding), static_cast<int>(m_size.y/2), currentColor);
-		Rectangle rec= {static_cast<float>(m_position.x + thumnnail_size + element_padding), static_cast<float>(m_position.y +m_size.y/2),
-						static_cast<float>(m_size.x - thumnnail_size - element_padding), static_cast<float>(m_size.y/2)};
-		DrawRectangleRounded(rec, 0.3f, 2, currentColor);
-		Vector2 pos= { (float)static_cast<int>(m_position.x + thumnnail_size + element_padding + (m_size.x - thumnnail_size - element_padding)/2 - MeasureText(m_text_button.c_str(), font_size)/2),
-					(float)static_cast<int>(m_position.y + 3*(m_size.y/4) - font_size/2.5)};
-		DrawTextEx(m_font, m_text_button.c_str(), pos, font_size, 2.0f, ui_text_light);
+		Color currentColor= IsMouseOver()  ? ui_element_hover : ui_element_body;
 
-		float scale= (m_texture->width> m_texture->height) ? thumnnail_size/(m_texture->width) : thumnnail_size/(m_texture->height);
-		DrawTextureEx(*m_texture, m_position, 0.0f, scale, WHITE);
+		Rectangle rec= {static_cast<float>(m_position.x), static_cast<float>(m_position.y), static_cast<float>(m_size.x), static_cast<float>(m_size.y)};
+		ui_draw_list->AddRectRounded(rec, 0.3f, 2, currentColor);
+		rec= {static_cast<float>(m_position.x +2), static_cast<float>(m_position.y +2), static_cast<float>(m_size.x -4), static_cast<float>(m_size.y -4)};
+		ui_draw_list->AddRectRounded(rec, 0.3f, 2, ui_panel_body);
+		const TextRun& label= m_label.Get(m_font, m_text);
+		Vector2 pos= { (float)static_cast<int>(m_position.x + m_size.x/2 - label.m_size.x/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
+		DrawTextRun(m_font, label, pos, ui_text_light);
 
-		Vector2 pos2= { (float)static_cast<int>(m_position.x + thumnnail_size + element_padding), (float)static_cast<int>(m_position.y + m_size.y/4 - font_size/2.5)};
-		DrawTextEx(m_font, m_text.c_str(), pos2, font_size, 2.0f, ui_text_light);
+		Vector2 pos2= {(float)static_cast<int>(m_position.x + m_size.x -10), pos.y +5};
+		ui_draw_list->AddTriangle((Vector2){pos2.x, pos2.y}, (Vector2){pos2.x +3, pos2.y +5}, (Vector2){pos2.x +6, pos2.y}, ui_element_hover);
+	}
+
+	void DrawOffscreen() override{
+		if(m_is_selected && m_panel) m_panel->DrawOffscreen();
+	}
+
+	void DrawOverlay() override{
+		if(m_is_selected && m_panel){
+			m_panel->Draw();
+			m_panel->DrawOverlay();
+		}
 	}
 };
 
-class ThumbnailGif: public GuiElement{
+//one console line, the text is stored inline so producers never allocate. longer lines are cut
+struct LogRecord{
+	static constexpr int max_length= 159;
+
+	int m_level= LOG_INFO;		//raylib's TraceLogLevel
+	int m_length= 0;
+	char m_text[max_length + 1];
+};
+
+//bounded multi-producer single-consumer queue of log records. producers claim a cell with a compare and swap on the head
+//and publish it through the cell's sequence number, the consumer only reads. a full queue drops the record instead of blocking
+class LogRing{
 public:
-	Image m_image_anim;
-	Texture2D m_texture_anim;
-	std::function<void()> m_call_back_function;
-	std::string m_text_button;
-	std::string m_gif_path;
-	int m_frames= 0;
-	unsigned int m_next_frame= 0;
-	int m_current_frame= 0;
-	int m_frame_delay= 8;
-	int m_frame_counter= 0;
+	explicit LogRing(size_t capacity){
+		size_t size= 2;
+		while(size< capacity) size<<= 1;
+		m_cells.reset(new Cell[size]);
+		m_mask= size - 1;
+		for(size_t i= 0; i< size; i++) m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+	}
 
-	ThumbnailGif(std::string text, const std::string& gif_path, std::function<void()> call_back_function, std::string text_button, int frame_delay= 8){
-		m_text= text;
-		m_gif_path= gif_path;
-		m_call_back_function= call_back_function;
-		m_text_button= text_button;
-		m_frame_delay= frame_delay;
+	//any thread
+	bool Push(int level, std::string_view text){
+		size_t position= m_head.load(std::memory_order_relaxed);
+		Cell *cell;
+		for(;;){
+			cell= &m_cells[position & m_mask];
+			size_t sequence= cell->m_sequence.load(std::memory_order_acquire);
+			long long difference= (long long)(sequence - position);
+			if(difference== 0){
+				if(m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+			}
+			else if(difference< 0){
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else position= m_head.load(std::memory_order_relaxed);
+		}
 
-		m_image_anim= LoadImageAnim(m_gif_path.c_str(), &m_frames);
-		m_texture_anim= LoadTextureFromImage(m_image_anim);
+		LogRecord& record= cell->m_record;
+		record.m_level= level;
+		record.m_length= (int)std::min(text.size(), (size_t)LogRecord::max_length);
+		memcpy(record.m_text, text.data(), record.m_length);
+		record.m_text[record.m_length]= '\0';
+		cell->m_sequence.store(position + 1, std::memory_order_release);
+		return true;
 	}
 
-	~ThumbnailGif(){
-		UnloadTexture(m_texture_anim);
-		UnloadImage(m_image_anim);
+	//consumer thread only, hands at most max_count published records to fn in order and frees their cells
+	template <typename Fn>
+	size_t Drain(Fn fn, size_t max_count){
+		size_t count= 0;
+		while(count< max_count){
+			Cell& cell= m_cells[m_tail & m_mask];
+			if(cell.m_sequence.load(std::memory_order_acquire)!= m_tail + 1) break;
+			fn(cell.m_record);
+			cell.m_sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+			m_tail++;
+			count++;
+		}
+		return count;
 	}
 
-	void Update() override{
-		m_frame_counter++;
-		if(m_frame_counter>= m_frame_delay){
-			m_current_frame++;
-			if(m_current_frame>= m_frames) m_current_frame= 0;
-				m_next_frame= m_image_anim.width *m_image_anim.height *4 *m_current_frame;
+	bool IsEmpty() const{ return m_cells[m_tail & m_mask].m_sequence.load(std::memory_order_acquire)!= m_tail + 1; }
+	long long GetDropped() const{ return m_dropped.load(std::memory_order_relaxed); }
+	size_t GetCapacity() const{ return m_mask + 1; }
 
-			UpdateTexture(m_texture_anim, ((unsigned char*)m_image_anim.data) +m_next_frame);
-				m_frame_counter= 0;
-		}
-		if(IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			if(m_call_back_function){
-				m_call_back_function();
-			}
-		}
+private:
+	struct Cell{
+		std::atomic<size_t> m_sequence;
+		LogRecord m_record;
+	};
+
+	std::unique_ptr<Cell[]> m_cells;
+	size_t m_mask= 0;
+	alignas(64) std::atomic<size_t> m_head{0};
+	alignas(64) size_t m_tail= 0;
+	std::atomic<long long> m_dropped{0};
+};
+
+//a log that any thread writes to with Log(). the console moves queued records into a bounded history once per frame and
+//only lays out the lines in view. scrolling up with the wheel stops following the tail, scrolling back down follows it again.
+//the severity filter and the search are applied by a scan that checks at most m_scan_budget lines per frame.
+//records wait in the queue while the console is not on screen, what does not fit is dropped and counted
+class Console: public GuiElement{
+public:
+	int m_rows= 12;
+	int m_min_level= LOG_ALL;
+	std::string m_search;
+	int *m_bound_level= nullptr;			//polled every frame, e.g. the value of a Slider
+	std::string *m_bound_search= nullptr;	//e.g. the text of an InputBox
+	bool m_is_following= true;
+	size_t m_drain_budget= 65536;			//records moved from the queue per frame
+	size_t m_scan_budget= 50000;			//history lines the filter checks per frame
+
+	Console(int rows= 12, size_t queue_capacity= 4096, size_t history= 16384): m_queue(queue_capacity){
+		m_rows= rows;
+		m_lines.resize(std::max(history, (size_t)1));
+		m_wants_update= true;
 	}
 
-	void Draw() override{		Color currentColor= IsMouseOver() ? 
-			(IsMouseButtonPressed(MOUSE_BUTTON_LEFT) ? ui_element_click : ui_element_hover) : ui_element_body;
-		// DrawRectangle(static_cast<int>(m_position.x + thumnnail_size + element_padding), static_cast<int>(m_position.y + m_size.y/2),
-		// 			  static_cast<int>(m_size.x - thumnnail_size - element_padding), static_cast<int>(m_size.y/2), currentColor);
+	//thread safe. every line of text becomes a record, false if the queue was full and something was dropped
+	bool Log(int level, std::string_view text){
+		bool is_queued= true;
+		size_t start= 0;
+		for(;;){
+			size_t end= text.find('\n', start);
+			is_queued&= m_queue.Push(level, text.substr(start, (end== std::string_view::npos) ? end : end - start));
+			if(end== std::string_view::npos) return is_queued;
+			start= end + 1;
+		}
+	}
 
-		Rectangle rec= {static_cast<float>(m_position.x + thumnnail_size + element_padding), static_cast<float>(m_position.y + m_size.y/2),
-					static_cast<float>(m_size.x - thumnnail_size - element_padding), static_cast<float>(m_size.y/2)};
-		DrawRectangleRounded(rec, 0.3f, 2, currentColor);
+	bool Logf(int level, const char *format, ...){
+		char buffer[512];
+		va_list args;
+		va_start(args, format);
+		vsnprintf(buffer, sizeof(buffer), format, args);
+		va_end(args);
+		return Log(level, buffer);
+	}
 
+	//the rest is for the UI thread
+	void SetMinLevel(int level){
+		if(m_min_level== level) return;
+		m_min_level= level;
+		Refilter();
+	}
 
-		Vector2 pos= {(float)static_cast<int>(m_position.x + thumnnail_size + element_padding + (m_size.x - thumnnail_size - element_padding)/2 - MeasureText(m_text_button.c_str(), font_size)/2),
-					(float)static_cast<int>(m_position.y + 3*(m_size.y/4) - font_size/2.5)};
-		DrawTextEx(m_font, m_text_button.c_str(), pos, font_size, 2.0f, ui_text_light);
+	void SetSearch(std::string_view text){
+		if(m_search== text) return;
+		m_search.assign(text.data(), text.size());
+		Refilter();
+	}
 
-		float scale= (m_texture_anim.width> m_texture_anim.height) ? thumnnail_size/(float)m_texture_anim.width : thumnnail_size/(float)m_texture_anim.height;
-		DrawTextureEx(m_texture_anim, m_position, 0.0f, scale, WHITE);
+	void BindFilter(int *min_level, std::string *search){
+		m_bound_level= min_level;
+		m_bound_search= search;
+	}
 
-		Vector2 pos2= {(float)static_cast<int>(m_position.x +thumnnail_size +element_padding), (float)static_cast<int>(m_position.y +m_size.y/4 -font_size/2.5)};
-		DrawTextEx(m_font, m_text.c_str(), pos2, font_size, 2.0f, ui_text_light);
+	void Clear(){
+		m_first= m_next;
+		Refilter();
 	}
-};
 
-class Billboard: public GuiElement{
-public:
-	Texture2D *m_texture;
+	long long GetLineCount() const{ return m_next - m_first; }
+	long long GetShownCount() const{ return ViewEnd() - ViewBegin(); }
+	long long GetDropped() const{ return m_queue.GetDropped(); }
+	bool IsFiltering() const{ return m_min_level> LOG_ALL || !m_search.empty(); }
 
-	Billboard(Texture2D &texture){
-		m_texture= &texture;
+	float MeasureHeight(float width) override{
+		return (float)((m_rows + 1)*font_size);
 	}
 
-	~Billboard(){
-		UnloadTexture(*m_texture);
+	//queued records, an unfinished scan or a bound filter that changed all need frames
+	bool IsAnimating() const override{
+		return !m_queue.IsEmpty() || (IsFiltering() && m_scan< m_next);
 	}
 
-	void Update() override{}
+	void Update() override{
+		if(m_bound_level) SetMinLevel(*m_bound_level);
+		if(m_bound_search) SetSearch(*m_bound_search);
+
+		size_t count= m_queue.Drain([&](const LogRecord& record){ Append(record); }, m_drain_budget);
+		long long dropped= m_queue.GetDropped();
+		if(count> 0 || dropped!= m_drawn_dropped) m_is_dirty= true;
+		if(IsFiltering()) Scan();
+
+		if(IsMouseOver() && ui_input.m_wheel!= 0){
+			m_wheel_lines-= ui_input.TakeWheel()*3.0f;
+			long long step= (long long)m_wheel_lines;
+			m_wheel_lines-= (float)step;
+			m_top+= step;
+			m_is_following= m_top>= ViewEnd() - m_rows;
+			m_is_dirty= true;
+		}
+		ClampTop();
+	}
 
 	void Draw() override{
-		float scale= (m_texture->width> m_texture->height) ? (float)m_size.x/(m_texture->width) : (float)m_size.x/(m_texture->height);
-		DrawTextureEx(*m_texture, m_position, 0.0f, scale, WHITE);
+		ClampTop();
+		Rectangle body= {m_position.x, m_position.y, m_size.x, (float)(m_rows*font_size)};
+		ui_draw_list->AddRect(body, ui_element_body);
+
+		//runs are kept per view position, scrolling by a line lays out only the line that came into view
+		if(m_runs.size()< (size_t)m_rows*2 || m_run_font!= m_font.texture.id){
+			m_runs.resize(std::max(m_runs.size(), (size_t)m_rows*2));
+			m_run_lines.assign(m_runs.size(), -1);
+			m_run_font= m_font.texture.id;
+		}
+		{
+			ClipScope clip(body);
+			long long end= std::min(ViewEnd(), m_top + m_rows);
+			for(long long position= m_top; position< end; position++){
+				long long line= LineAt(position);
+				const LogRecord& record= m_lines[line % (long long)m_lines.size()];
+				size_t slot= (size_t)(position % (long long)m_runs.size());
+				if(m_run_lines[slot]!= line){
+					TextCache::Layout(m_font, record.m_text, font_size, text_spacing, m_runs[slot]);
+					m_run_lines[slot]= line;
+				}
+				Vector2 pos= {(float)static_cast<int>(m_position.x + element_padding), (float)static_cast<int>(m_position.y + (position - m_top)*font_size)};
+				DrawTextRun(m_font, m_runs[slot], pos, LevelColor(record.m_level));
+			}
+		}
+
+		//the status row is only laid out again when its numbers change
+		m_drawn_dropped= m_queue.GetDropped();
+		char status[sizeof(m_status)];
+		if(IsFiltering()) snprintf(status, sizeof(status), "%lld of %lld lines  %lld dropped%s", GetShownCount(), GetLineCount(), m_drawn_dropped, (m_scan< m_next) ? "  searching" : "");
+		else snprintf(status, sizeof(status), "%lld lines  %lld dropped", GetLineCount(), m_drawn_dropped);
+		if(strcmp(status, m_status)!= 0 || m_status_font!= m_font.texture.id){
+			memcpy(m_status, status, sizeof(m_status));
+			m_status_font= m_font.texture.id;
+			TextCache::Layout(m_font, m_status, font_size, text_spacing, m_status_run);
+		}
+		Vector2 pos= {(float)static_cast<int>(m_position.x + element_padding), (float)static_cast<int>(m_position.y + m_rows*font_size + font_size/2 - font_size/2.5)};
+		DrawTextRun(m_font, m_status_run, pos, m_is_following ? ui_special : ui_text_light);
 	}
-};
 
-class BillboardGif: public GuiElement{
-public:
-	Image m_image_anim;
-	Texture2D m_texture_anim;
-	int m_frames= 0;
-	unsigned int m_next_frame= 0;
-	int m_current_frame= 0;
-	int *m_frame_delay;
-	int m_frame_counter= 0;
-	std::string m_gif_path;
+private:
+	LogRing m_queue;
+	std::vector<LogRecord> m_lines;		//history ring, line n lives at n % size
+	long long m_first= 0;				//oldest line still kept
+	long long m_next= 0;				//number of lines ever added
+
+	//lines that pass the filter, positions in the view count from m_view_base so they survive dropping old entries
+	std::vector<long long> m_view;
+	size_t m_view_start= 0;
+	long long m_view_base= 0;
+	long long m_scan= 0;				//next history line the filter has to check
+
+	long long m_top= 0;					//view position of the first visible line
+	float m_wheel_lines= 0.0f;
+	std::vector<TextRun> m_runs;
+	std::vector<long long> m_run_lines;
+	unsigned int m_run_font= 0;
+	char m_status[96]= "";
+	TextRun m_status_run;
+	unsigned int m_status_font= 0;
+	long long m_drawn_dropped= 0;
+
+	void Append(const LogRecord& record){
+		LogRecord& line= m_lines[m_next % (long long)m_lines.size()];
+		line.m_level= record.m_level;
+		line.m_length= record.m_length;
+		memcpy(line.m_text, record.m_text, record.m_length + 1);
+		m_next++;
+		if(m_next - m_first> (long long)m_lines.size()) m_first= m_next - (long long)m_lines.size();
+	}
 
-	BillboardGif(const std::string& gif_path, int &frame_delay){
-		m_gif_path= gif_path;
-		m_frame_delay= &frame_delay;
-		m_image_anim= LoadImageAnim(m_gif_path.c_str(), &m_frames);
-		m_texture_anim= LoadTextureFromImage(m_image_anim);
+	bool Matches(const LogRecord& record) const{
+		return record.m_level>= m_min_level && (m_search.empty() || std::string_view(record.m_text, record.m_length).find(m_search)!= std::string_view::npos);
 	}
 
-	~BillboardGif(){
-		UnloadTexture(m_texture_anim);
-		UnloadImage(m_image_anim);
+	void Refilter(){
+		m_view.clear();
+		m_view_start= 0;
+		m_view_base= 0;
+		m_scan= m_first;
+		m_is_following= true;
+		m_top= 0;
+		m_is_dirty= true;
+		std::fill(m_run_lines.begin(), m_run_lines.end(), -1);
 	}
 
-	void Update() override{
-		m_frame_counter++;
-		if(m_frame_counter >= *m_frame_delay){
-			m_current_frame++;
-			if(m_current_frame>= m_frames) m_current_frame= 0;
-				m_next_frame= m_image_anim.width *m_image_anim.height *4 *m_current_frame;
+	void Scan(){
+		if(m_scan< m_first) m_scan= m_first;
+		long long end= std::min(m_next, m_scan + (long long)m_scan_budget);
+		for(; m_scan< end; m_scan++){
+			if(Matches(m_lines[m_scan % (long long)m_lines.size()])){
+				m_view.push_back(m_scan);
+				m_is_dirty= true;
+			}
+		}
+		//matches that fell out of the history, compacted once they are half of the list
+		while(m_view_start< m_view.size() && m_view[m_view_start]< m_first) m_view_start++;
+		if(m_view_start> 1024 && m_view_start*2> m_view.size()){
+			m_view.erase(m_view.begin(), m_view.begin() + m_view_start);
+			m_view_base+= (long long)m_view_start;
+			m_view_start= 0;
+		}
+	}
 
-			UpdateTexture(m_texture_anim, ((unsigned char*)m_image_anim.data) + m_next_frame);
-				m_frame_counter= 0;
+	long long ViewBegin() const{ return IsFiltering() ? m_view_base + (long long)m_view_start : m_first; }
+	long long ViewEnd() const{ return IsFiltering() ? m_view_base + (long long)m_view.size() : m_next; }
+	long long LineAt(long long position) const{ return IsFiltering() ? m_view[position - m_view_base] : position; }
+
+	void ClampTop(){
+		long long begin= ViewBegin();
+		long long last= std::max(begin, ViewEnd() - m_rows);
+		long long top= m_is_following ? last : std::clamp(m_top, begin, last);
+		if(top!= m_top){
+			m_top= top;
+			m_is_dirty= true;
 		}
 	}
 
-	void Draw() override{
-		float scale= (m_texture_anim.width> m_texture_anim.height) ? m_size.x/(float)m_texture_anim.width : m_size.x/(float)m_texture_anim.height;
-		DrawTextureEx(m_texture_anim, m_position, 0.0f, scale, WHITE);
+	static Color LevelColor(int level){
+		if(level>= LOG_ERROR) return ui_log_error;
+		if(level== LOG_WARNING) return ui_log_warning;
+		if(level<= LOG_DEBUG) return ui_special;
+		return ui_text_light;
 	}
 };
 
-class CameraView3D : public GuiElement{
+//a grid that asks for its cells while it draws them. the provider writes the text of one cell into a buffer, so the data stays
+//wherever the caller keeps it and only what is on screen is ever laid out: one run per visible cell, kept until another row
+//moves into its place. sorting fills a key per row and sorts a permutation of the rows on worker threads, the current order
+//stays on screen until the new one is ready
+class Table: public GuiElement{
 public:
-	Camera3D *m_camera;
-	RenderTexture m_render_texture;
-	Color m_color;
-	std::function<void(Camera3D&)> m_draw_scene_function;
-	int m_width= 0;
-	bool m_update_camera= false;
-	bool m_is_calculated= false;
+	//writes a null terminated string into buffer. without a sort key it is also called from the sorting threads
+	using CellProvider= std::function<void(int row, int column, char *buffer, int size)>;
+	//called from the sorting threads, rows are ordered by it instead of by their text
+	using SortKey= std::function<double(int row, int column)>;
+
+	struct Column{
+		std::string m_title;
+		float m_width= 100.0f;
+		CachedText m_title_run;
+	};
 
-	CameraView3D(Camera3D &camera, std::function<void(Camera3D&)> draw_scene_function, Color background_color){
-		m_camera= &camera;
-		m_draw_scene_function= draw_scene_function;
-		m_color= background_color;
+	std::vector<Column> m_columns;
+	CellProvider m_cell_provider;
+	SortKey m_sort_key;
+	int m_row_count= 0;
+	int m_rows= 12;					//visible rows
+	int m_sort_threads= 0;			//0 picks from the number of cores
+	float m_min_column_width= 24.0f;
+
+	Table(int rows, int row_count, CellProvider cell_provider): m_cell_provider(cell_provider){
+		m_rows= rows;
+		m_row_count= std::max(row_count, 0);
 	}
 
-	~CameraView3D(){
-		UnloadRenderTexture(m_render_texture);
+	~Table(){
+		m_is_cancelled= true;
+		if(m_sorter.joinable()) m_sorter.join();
 	}
 
-	void Update() override{
-		if(m_is_calculated== false){
-			m_width= m_size.x;
-			m_render_texture= LoadRenderTexture(m_width, m_width);
-			m_is_calculated= true;
-		}
+	void AddColumn(std::string title, float width= 100.0f){
+		m_columns.emplace_back();
+		m_columns.back().m_title= title;
+		m_columns.back().m_width= std::max(width, m_min_column_width);
+		UpdateOffsets();
+		m_slot_rows.clear();
+	}
 
-		if(IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			m_update_camera= true;
-			DisableCursor();
-		}
-		else if(IsKeyPressed(KEY_ESCAPE)){
-			m_update_camera= false;
-			EnableCursor();
+	//the provider's data grew or shrank, a sorted table sorts again. a running sort starts over once it is done
+	void SetRowCount(int count){
+		count= std::max(count, 0);
+		if(count== m_row_count) return;
+		m_row_count= count;
+		Invalidate();
+		if(m_sort_column>= 0 && !IsSorting()){
+			int column= m_sort_column;
+			m_order.clear();
+			m_sort_column= -1;
+			SortBy(column, m_is_descending);
 		}
+	}
 
-		if(m_update_camera){
-			UpdateCamera(m_camera, CAMERA_CUSTOM);
+	//cells changed, the visible ones are asked for again
+	void Invalidate(){
+		std::fill(m_slot_rows.begin(), m_slot_rows.end(), -1);
+		m_is_dirty= true;
+	}
+
+	//a sort that is already running finishes first, its result is thrown away
+	void SortBy(int column, bool is_descending= false){
+		if(column< 0 || column>= (int)m_columns.size()) return;
+		if(IsSorting()){
+			m_queued_column= column;
+			m_queued_descending= is_descending;
+			m_is_cancelled= true;
+			return;
 		}
+		if(m_sorter.joinable()) m_sorter.join();
+		StartSort(column, is_descending);
 	}
 
-	void Draw() override{
-		BeginTextureMode(m_render_texture);
-			ClearBackground(m_color);
-				BeginMode3D(*m_camera);
-				if(m_draw_scene_function) m_draw_scene_function(*m_camera);
-			EndMode3D();
-		EndTextureMode();
+	bool IsSorting() const{ return m_sorting_column>= 0; }
+	int GetSortColumn() const{ return m_sort_column; }
+	bool IsDescending() const{ return m_is_descending; }
 
-		Rectangle sourceRec= {0.0f, 0.0f, (float)m_render_texture.texture.width, (float)-m_render_texture.texture.height};
-		DrawTextureRec(m_render_texture.texture, sourceRec, m_position, WHITE);
+	//data row shown at a position of the view
+	int RowAt(int position) const{
+		if(m_order.size()!= (size_t)m_row_count) return position;
+		return m_is_descending ? m_order[m_row_count - 1 - position] : m_order[position];
 	}
 
-	RenderTexture& GetRenderTexture(){
-		return m_render_texture;
+	void ScrollTo(int position){
+		m_top= position;
+		ClampScroll();
+		m_is_dirty= true;
 	}
-};
-
-class CameraView3DFill : public GuiElement{
-public:
-	Camera3D *m_camera;
-	RenderTexture m_render_texture;
-	Color m_color;
-	std::function<void(Camera3D&)> m_draw_scene_function;
-	bool m_update_camera= false;
-	bool m_is_calculated= false;
 
-	CameraView3DFill(Camera3D &camera, std::function<void(Camera3D&)> draw_scene_function, Color color){
-		m_camera= &camera;
-		m_draw_scene_function= draw_scene_function;
-		m_color= color;
+	float MeasureHeight(float width) override{
+		return (float)((m_rows + 1)*font_size);
 	}
 
-	~CameraView3DFill(){
-		UnloadRenderTexture(m_render_texture);
-	}
+	//a running sort has to be picked up when it is done
+	bool IsAnimating() const override{ return IsSorting(); }
 
 	void Update() override{
-		if(m_is_calculated== false){
-			m_render_texture= LoadRenderTexture(m_size.x +12, m_size.y);	//altered "+12"
-			m_is_calculated= true;
+		if(m_sorter.joinable() && m_is_sort_done.load(std::memory_order_acquire)) FinishSort();
+
+		Vector2 mouse= ui_input.m_mouse;
+		bool is_mouse_over= IsMouseOver();
+		if(is_mouse_over && ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			if(mouse.y< m_position.y + font_size){
+				int separator= SeparatorAt(mouse.x);
+				int column= ColumnAt(mouse.x);
+				if(separator>= 0){
+					m_resizing= separator;
+					ui_focus.SetFocus(this);
+				}
+				else if(column>= 0 && column== m_sort_column && !IsSorting()){
+					m_is_descending= !m_is_descending;
+					Invalidate();
+				}
+				else if(column>= 0){
+					SortBy(column);
+				}
+			}
+			else if(mouse.x>= m_position.x + GetViewWidth()){
+				m_is_dragging_bar= true;
+				ui_focus.SetFocus(this);
+			}
 		}
 
-		if(IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			m_update_camera= true;
-			DisableCursor();
-		}
-		else if(IsKeyPressed(KEY_ESCAPE)){
-			m_update_camera= false;
-			EnableCursor();
+		if(m_resizing>= 0 || m_is_dragging_bar){
+			if(!ui_input.IsDown(MOUSE_BUTTON_LEFT)){
+				ui_focus.ClearFocus(this);
+			}
+			else if(m_resizing>= 0 && ui_input.m_delta.x!= 0){
+				Column& column= m_columns[m_resizing];
+				column.m_width= std::max(m_min_column_width, column.m_width + ui_input.m_delta.x);
+				UpdateOffsets();
+				m_is_dirty= true;
+			}
+			else if(m_is_dragging_bar){
+				float body= (float)(m_rows*font_size);
+				float fraction= std::clamp((mouse.y - m_position.y - font_size)/body, 0.0f, 1.0f);
+				int top= (int)(fraction*(m_row_count - m_rows));
+				if(top!= m_top) ScrollTo(top);
+			}
 		}
 
-		if(m_update_camera){
-			UpdateCamera(m_camera, CAMERA_CUSTOM);
+		if(is_mouse_over && ui_input.m_wheel!= 0){
+			if(mouse.y< m_position.y + font_size){
+				m_scroll_x-= ui_input.TakeWheel()*40.0f;
+			}
+			else{
+				m_wheel_rows-= ui_input.TakeWheel()*3.0f;
+				int step= (int)m_wheel_rows;
+				m_wheel_rows-= (float)step;
+				m_top+= step;
+			}
+			m_is_dirty= true;
 		}
+		ClampScroll();
+	}
+
+	void FocusChanged(bool is_focused) override{
+		if(is_focused) return;
+		m_resizing= -1;
+		m_is_dragging_bar= false;
 	}
 
 	void Draw() override{
-		BeginTextureMode(m_render_texture);
-			ClearBackground(m_color);
-			BeginMode3D(*m_camera);
-				if(m_draw_scene_function) m_draw_scene_function(*m_camera);
-			EndMode3D();
-		EndTextureMode();
+		ClampScroll();
+		float view_width= GetViewWidth();
+		Rectangle header= {m_position.x, m_position.y, m_size.x, (float)font_size};
+		Rectangle body= {m_position.x, m_position.y + font_size, view_width, (float)(m_rows*font_size)};
+		ui_draw_list->AddRect(header, ui_panel_header);
+		ui_draw_list->AddRect(body, ui_element_body);
+
+		//runs are kept per view position and column, scrolling by a row lays out only the cells that came into view
+		size_t slot_count= (size_t)m_rows*2*m_columns.size();
+		if(m_slot_rows.size()!= slot_count || m_slot_font!= m_font.texture.id){
+			m_slots.resize(std::max(m_slots.size(), slot_count));
+			m_slot_rows.assign(slot_count, -1);
+			m_slot_font= m_font.texture.id;
+		}
 
-		Rectangle sourceRec= {0.0f, 0.0f, (float)m_render_texture.texture.width, (float)-m_render_texture.texture.height};
-		DrawTextureRec(m_render_texture.texture, sourceRec, (Vector2){m_position.x -6, m_position.y}, WHITE);	//altered "-6"
+		int first= std::max(0, (int)(std::upper_bound(m_offsets.begin(), m_offsets.end(), m_scroll_x) - m_offsets.begin()) - 1);
+		int end= std::min(m_row_count, m_top + m_rows);
+		float right= m_position.x + view_width;
+		for(int column= first; column< (int)m_columns.size(); column++){
+			float x= m_position.x + m_offsets[column] - m_scroll_x;
+			if(x>= right) break;
+			Column& info= m_columns[column];
+			float left_limit= std::max(x + element_padding, m_position.x);
+			float right_limit= std::min(x + info.m_width - element_padding, right);
+
+			Color title_color= (column== m_sorting_column) ? ui_special : ui_text_light;
+			DrawClipped(info.m_title_run.Get(m_font, info.m_title), (Vector2){(float)static_cast<int>(x + element_padding), m_position.y}, left_limit, right_limit - ((column== m_sort_column) ? 8 : 0), title_color);
+			if(column== m_sort_column && x + info.m_width - 8> m_position.x){
+				float cx= x + info.m_width - element_padding - 4, cy= m_position.y + font_size/2.0f;
+				if(m_is_descending) ui_draw_list->AddTriangle((Vector2){cx - 3, cy - 2}, (Vector2){cx, cy + 2}, (Vector2){cx + 3, cy - 2}, ui_special);
+				else ui_draw_list->AddTriangle((Vector2){cx - 3, cy + 2}, (Vector2){cx + 3, cy + 2}, (Vector2){cx, cy - 2}, ui_special);
+			}
+
+			for(int position= m_top; position< end; position++){
+				int row= RowAt(position);
+				size_t slot= (size_t)(position % (m_rows*2))*m_columns.size() + column;
+				if(m_slot_rows[slot]!= row){
+					char cell[128];
+					cell[0]= '\0';
+					m_cell_provider(row, column, cell, sizeof(cell));
+					TextCache::Layout(m_font, cell, font_size, text_spacing, m_slots[slot]);
+					m_slot_rows[slot]= row;
+				}
+				Vector2 pos= {(float)static_cast<int>(x + element_padding), body.y + (position - m_top)*font_size};
+				DrawClipped(m_slots[slot], pos, left_limit, right_limit, ui_text_light);
+			}
+
+			float separator= x + info.m_width - 1;
+			if(separator>= m_position.x && separator< right){
+				ui_draw_list->AddRect((Rectangle){separator, m_position.y, 1, header.height + body.height}, (column== m_resizing) ? ui_special : ui_panel_body);
+			}
+		}
+
+		if(m_row_count> m_rows){
+			Rectangle track= {right, body.y, m_size.x - view_width, body.height};
+			float thumb= std::max(8.0f, track.height*m_rows/m_row_count);
+			float offset= (track.height - thumb)*m_top/(m_row_count - m_rows);
+			ui_draw_list->AddRect(track, ui_panel_body);
+			ui_draw_list->AddRect((Rectangle){track.x + 1, track.y + offset, track.width - 2, thumb}, m_is_dragging_bar ? ui_special_h : ui_special);
+		}
 	}
 
-	RenderTexture& GetRenderTexture(){
-		return m_render_texture;
+private:
+	static constexpr float bar_width= 6.0f;
+
+	std::vector<float> m_offsets;			//left edge of every column and the total width at the end
+	int m_top= 0;							//view position of the first visible row
+	float m_wheel_rows= 0.0f;
+	float m_scroll_x= 0.0f;
+	int m_resizing= -1;						//column whose right edge is dragged
+	bool m_is_dragging_bar= false;
+	std::vector<TextRun> m_slots;
+	std::vector<int> m_slot_rows;
+	unsigned int m_slot_font= 0;
+
+	std::vector<int> m_order;				//view position to row, empty while unsorted
+	int m_sort_column= -1;
+	bool m_is_descending= false;
+
+	//the sorter owns m_sorted, m_sort_keys, m_sort_texts, m_sort_strings and m_sort_buffer until m_is_sort_done is set
+	std::thread m_sorter;
+	std::atomic<bool> m_is_sort_done{false};
+	std::atomic<bool> m_is_cancelled{false};
+	std::vector<int> m_sorted;
+	std::vector<uint64_t> m_sort_keys;
+	std::vector<std::vector<char>> m_sort_texts;	//per slice, the cells longer than their key
+	std::vector<const char*> m_sort_strings;		//per row into m_sort_texts, null when the key holds the whole cell
+	std::vector<int> m_sort_buffer;
+	int m_sorting_column= -1;
+	bool m_sorting_descending= false;
+	int m_queued_column= -1;
+	bool m_queued_descending= false;
+
+	float GetViewWidth() const{ return std::max(0.0f, m_size.x - bar_width); }
+
+	void UpdateOffsets(){
+		m_offsets.resize(m_columns.size() + 1);
+		m_offsets[0]= 0.0f;
+		for(size_t i= 0; i< m_columns.size(); i++) m_offsets[i + 1]= m_offsets[i] + m_columns[i].m_width;
 	}
-};
 
-class CameraView3DFillBorder : public GuiElement{
-public:
-	Camera3D *m_camera;
-	RenderTexture m_render_texture;
-	Color m_color;
-	std::function<void(Camera3D&)> m_draw_scene_function;
-	bool m_update_camera= false;
-	bool m_is_calculated= false;
+	void ClampScroll(){
+		int top= std::clamp(m_top, 0, std::max(0, m_row_count - m_rows));
+		float scroll_x= std::clamp(m_scroll_x, 0.0f, std::max(0.0f, (m_offsets.empty() ? 0.0f : m_offsets.back()) - GetViewWidth()));
+		if(top!= m_top || scroll_x!= m_scroll_x){
+			m_top= top;
+			m_scroll_x= scroll_x;
+			m_is_dirty= true;
+		}
+	}
 
-	CameraView3DFillBorder(Camera3D &camera, std::function<void(Camera3D&)> draw_scene_function, Color color){
-		m_camera= &camera;
-		m_draw_scene_function= draw_scene_function;
-		m_color= color;
+	int ColumnAt(float x) const{
+		float content= x - m_position.x + m_scroll_x;
+		int column= (int)(std::upper_bound(m_offsets.begin(), m_offsets.end(), content) - m_offsets.begin()) - 1;
+		return (column>= 0 && column< (int)m_columns.size()) ? column : -1;
 	}
 
-	~CameraView3DFillBorder(){
-		UnloadRenderTexture(m_render_texture);
+	//a column whose right edge is within a few pixels of x
+	int SeparatorAt(float x) const{
+		float content= x - m_position.x + m_scroll_x;
+		for(size_t i= 1; i< m_offsets.size(); i++){
+			if(std::fabs(m_offsets[i] - content)<= 3.0f) return (int)i - 1;
+		}
+		return -1;
 	}
 
-	void Update() override{
-		if(m_is_calculated== false){
-			m_render_texture= LoadRenderTexture(m_size.x, m_size.y);
-			m_is_calculated= true;
+	//glyphs that do not fit between left and right are left out, text is cut without a clip rect per cell
+	void DrawClipped(const TextRun& run, Vector2 position, float left, float right, Color tint){
+		for(const auto& glyph : run.m_glyphs){
+			Rectangle dest= {position.x + glyph.m_dest.x, position.y + glyph.m_dest.y, glyph.m_dest.width, glyph.m_dest.height};
+			if(dest.x< left) continue;
+			if(dest.x + dest.width> right) break;
+			ui_draw_list->AddTexture(m_font.texture, glyph.m_source, dest, tint, DrawList::LAYER_TEXT);
 		}
+	}
+
+	void StartSort(int column, bool is_descending){
+		m_sorting_column= column;
+		m_sorting_descending= is_descending;
+		m_is_sort_done= false;
+		m_is_cancelled= false;
+		m_is_dirty= true;
+		SetWantsUpdate(true);
+		int count= m_row_count;
+		int threads= (m_sort_threads> 0) ? m_sort_threads : std::clamp((int)std::thread::hardware_concurrency(), 1, 8);
+		m_sorter= std::thread([this, column, count, threads](){
+			SortRows(column, count, threads);
+			m_is_sort_done.store(true, std::memory_order_release);
+		});
+	}
 
-		if(IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			m_update_camera= true;
-			DisableCursor();
+	void FinishSort(){
+		m_sorter.join();
+		bool is_stale= m_sorted.size()!= (size_t)m_row_count;
+		if(!m_is_cancelled && !is_stale){
+			m_order.swap(m_sorted);
+			m_sort_column= m_sorting_column;
+			m_is_descending= m_sorting_descending;
+			Invalidate();
 		}
-		else if(IsKeyPressed(KEY_ESCAPE)){
-			m_update_camera= false;
-			EnableCursor();
+		else if(is_stale && m_queued_column< 0){
+			//the row count changed while sorting
+			m_queued_column= m_sorting_column;
+			m_queued_descending= m_sorting_descending;
 		}
-
-		if(m_update_camera){
-			UpdateCamera(m_camera, CAMERA_CUSTOM);
+		m_sorting_column= -1;
+		m_is_dirty= true;
+		if(m_queued_column>= 0){
+			int column= m_queued_column;
+			m_queued_column= -1;
+			StartSort(column, m_queued_descending);
+		}
+		else{
+			SetWantsUpdate(false);
 		}
 	}
 
-	void Draw() override{
-		BeginTextureMode(m_render_texture);
-			ClearBackground(m_color);
-			BeginMode3D(*m_camera);
-				if(m_draw_scene_function) m_draw_scene_function(*m_camera);
-			EndMode3D();
-		EndTextureMode();
+	//runs fn(begin, end) over count items split into one range per thread, the calling thread takes the first
+	template<class Function>
+	static void ParallelFor(int threads, int count, Function fn){
+		threads= std::max(1, std::min(threads, count));
+		std::vector<std::thread> workers;
+		for(int t= 1; t< threads; t++) workers.emplace_back(fn, (int)((long long)count*t/threads), (int)((long long)count*(t + 1)/threads));
+		fn(0, (int)((long long)count/threads));
+		for(std::thread& worker : workers) worker.join();
+	}
 
-		Rectangle sourceRec= {0.0f, 0.0f, (float)m_render_texture.texture.width, (float)-m_render_texture.texture.height};
-		DrawTextureRec(m_render_texture.texture, sourceRec, m_position, WHITE);
+	//numbers keep their order as unsigned integers, text is compared by its first 8 bytes and then by the rest of it
+	static uint64_t NumberKey(double value){
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return (bits & 0x8000000000000000ull) ? ~bits : bits | 0x8000000000000000ull;
 	}
 
-	RenderTexture& GetRenderTexture(){
-		return m_render_texture;
+	static uint64_t TextKey(const char *text){
+		uint64_t key= 0;
+		for(int i= 0; i< 8; i++){
+			key= (key << 8) | (unsigned char)text[i];
+			if(text[i]== '\0'){
+				key<<= 8*(7 - i);
+				break;
+			}
+		}
+		return key;
+	}
+
+	//sorter thread: a key per row, every thread sorts a slice of the permutation, then the slices are merged pairwise.
+	//text cells that don't fit their key are copied into a buffer per slice and compared in full when the keys are equal.
+	//only identical cells are ordered by their row, so the result does not depend on how the rows were split
+	void SortRows(int column, int count, int threads){
+		threads= std::max(1, std::min(threads, count/4096 + 1));
+		m_sort_keys.resize(count);
+		m_sorted.resize(count);
+		std::vector<int> bounds(threads + 1);
+		for(int t= 0; t<= threads; t++) bounds[t]= (int)((long long)count*t/threads);
+		bool is_text= !m_sort_key;
+		if(is_text){
+			m_sort_texts.resize(threads);
+			for(std::vector<char>& texts : m_sort_texts) texts.clear();
+			m_sort_strings.resize(count);
+		}
+		ParallelFor(threads, threads, [&](int begin, int end){
+			char cell[128];
+			std::vector<std::pair<int, size_t>> long_cells;		//row and offset, the slice buffer may still move while it grows
+			for(int t= begin; t< end; t++){
+				long_cells.clear();
+				for(int row= bounds[t]; row< bounds[t + 1]; row++){
+					if((row & 4095)== 0 && m_is_cancelled.load(std::memory_order_relaxed)) return;
+					m_sorted[row]= row;
+					if(!is_text){
+						m_sort_keys[row]= NumberKey(m_sort_key(row, column));
+						continue;
+					}
+					cell[0]= '\0';
+					m_cell_provider(row, column, cell, sizeof(cell));
+					m_sort_keys[row]= TextKey(cell);
+					m_sort_strings[row]= nullptr;
+					size_t length= strlen(cell);
+					if(length>= 8){
+						long_cells.emplace_back(row, m_sort_texts[t].size());
+						m_sort_texts[t].insert(m_sort_texts[t].end(), cell, cell + length + 1);
+					}
+				}
+				for(const std::pair<int, size_t>& long_cell : long_cells) m_sort_strings[long_cell.first]= m_sort_texts[t].data() + long_cell.second;
+			}
+		});
+		if(m_is_cancelled) return;
+
+		const std::vector<uint64_t>& keys= m_sort_keys;
+		const std::vector<const char*>& strings= m_sort_strings;
+		//equal text keys either both hold their whole cell or both need the rest compared
+		auto less= [&keys, &strings, is_text](int a, int b){
+			if(keys[a]!= keys[b]) return keys[a]< keys[b];
+			if(is_text && strings[a]){
+				int order= strcmp(strings[a], strings[b]);
+				if(order!= 0) return order< 0;
+			}
+			return a< b;
+		};
+		ParallelFor(threads, threads, [&](int begin, int end){
+			for(int t= begin; t< end; t++) std::sort(m_sorted.begin() + bounds[t], m_sorted.begin() + bounds[t + 1], less);
+		});
+
+		m_sort_buffer.resize(count);
+		while(bounds.size()> 2 && !m_is_cancelled){
+			std::vector<int> merged;
+			for(size_t i= 0; i + 1< bounds.size(); i+= 2) merged.push_back(bounds[i]);
+			merged.push_back(count);
+			int slices= (int)bounds.size() - 1;
+			int pairs= (slices + 1)/2;
+			ParallelFor(pairs, pairs, [&](int begin, int end){
+				for(int p= begin; p< end; p++){
+					int lo= bounds[p*2], mid= bounds[std::min(p*2 + 1, (int)bounds.size() - 1)], hi= bounds[std::min(p*2 + 2, (int)bounds.size() - 1)];
+					std::merge(m_sorted.begin() + lo, m_sorted.begin() + mid, m_sorted.begin() + mid, m_sorted.begin() + hi, m_sort_buffer.begin() + lo, less);
+				}
+			});
+			m_sorted.swap(m_sort_buffer);
+			bounds.swap(merged);
+		}
 	}
 };
 
-class ColorPicker: public GuiElement{
+//a live chart of a few series. samples go into a ring per series and the visible window is reduced to the min and max of
+//every pixel column when it is drawn. buckets start at multiples of their size in the whole stream, so a full bucket never
+//changes again and a frame only reduces the samples pushed since the last one. Push() also keeps the min and max of every
+//block of 64 samples, a zoom that changes the bucket size reduces those instead of the samples. every series is drawn as
+//one polyline. Push() is for the UI thread, other threads can hand their samples over e.g. with a SharedValue
+class Plot: public GuiElement{
 public:
-	Color *m_color;
-	int m_r= 255;
-	int m_g= 0;
-	int m_b= 0;
-	int m_a= 255;
+	struct Series{
+		std::string m_name;
+		Color m_color;
+		std::vector<float> m_samples;	//ring, sample n lives at n & (size - 1)
+		long long m_total= 0;			//samples ever pushed
+		CachedText m_label;
+
+		//min and max of every block, block n at n & (size - 1)
+		std::vector<float> m_block_low;
+		std::vector<float> m_block_high;
+
+		//reduced buckets, bucket n at n % size, valid for one bucket size and window
+		std::vector<float> m_low;
+		std::vector<float> m_high;
+		long long m_bucket_size= 0;
+		long long m_window= 0;
+		long long m_done= 0;			//buckets before this one are full and already reduced
+	};
 
-	bool m_calculated= false;
+	std::vector<Series> m_series;
+	int m_rows= 8;
+	long long m_window= 0;				//newest samples shown, 0 for the whole ring. the wheel zooms it
+	float m_min= 0.0f;					//fixed range, fitted to what is shown while m_min>= m_max
+	float m_max= 0.0f;
+	float m_thickness= 1.0f;
 
-	Vector2 m_slider_size= {m_size.x/4, font_size};
-	Vector2 m_pos_r= {m_position.x + (m_size.x/4)*3, m_position.y + font_size + element_padding};
-	Vector2 m_pos_g= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*2 + element_padding*2};
-	Vector2 m_pos_b= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*3 + element_padding*3};
-	Vector2 m_pos_a= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*4 + element_padding*4};
+	static constexpr size_t block_size= 64;
 
-	bool m_is_active_r= false;
-	bool m_is_active_g= false;
-	bool m_is_active_b= false;
-	bool m_is_active_a= false;
+	//capacity is rounded up to a power of two
+	Plot(int rows= 8, size_t capacity= 65536){
+		m_rows= rows;
+		m_capacity= block_size;
+		while(m_capacity< capacity) m_capacity<<= 1;
+	}
 
-	Rectangle m_rec_r= {m_pos_r.x, m_pos_r.y, m_slider_size.x, m_slider_size.y};
-	Rectangle m_rec_g= {m_pos_g.x, m_pos_g.y, m_slider_size.x, m_slider_size.y};
-	Rectangle m_rec_b= {m_pos_b.x, m_pos_b.y, m_slider_size.x, m_slider_size.y};
-	Rectangle m_rec_a= {m_pos_a.x, m_pos_a.y, m_slider_size.x, m_slider_size.y};
+	int AddSeries(std::string name, Color color){
+		m_series.emplace_back();
+		Series& series= m_series.back();
+		series.m_name= name;
+		series.m_color= color;
+		series.m_samples.resize(m_capacity);
+		series.m_block_low.resize(m_capacity/block_size);
+		series.m_block_high.resize(m_capacity/block_size);
+		m_is_dirty= true;
+		return (int)m_series.size() - 1;
+	}
 
+	void Push(int index, float value){
+		Series& series= m_series[index];
+		series.m_samples[series.m_total & (m_capacity - 1)]= value;
+		size_t block= (size_t)(series.m_total/(long long)block_size) & (series.m_block_low.size() - 1);
+		if(series.m_total % (long long)block_size== 0){
+			series.m_block_low[block]= FLT_MAX;
+			series.m_block_high[block]= -FLT_MAX;
+		}
+		series.m_block_low[block]= (value< series.m_block_low[block]) ? value : series.m_block_low[block];
+		series.m_block_high[block]= (value> series.m_block_high[block]) ? value : series.m_block_high[block];
+		series.m_total++;
+		m_is_dirty= true;
+	}
 
-	ColorPicker(std::string text, Color &color){
-		m_text= text;
-		m_color= &color;
+	void Push(int index, const float *values, size_t count){
+		Series& series= m_series[index];
+		if(count> m_capacity){
+			series.m_total+= (long long)(count - m_capacity);
+			values+= count - m_capacity;
+			count= m_capacity;
+		}
+		long long from= series.m_total;
+		while(count> 0){
+			size_t begin= series.m_total & (m_capacity - 1);
+			size_t span= std::min(count, m_capacity - begin);
+			std::copy(values, values + span, series.m_samples.begin() + begin);
+			series.m_total+= (long long)span;
+			values+= span;
+			count-= span;
+		}
+		//blocks the new samples went into, the first one may have older samples of its own
+		for(long long block= from/(long long)block_size; block*(long long)block_size< series.m_total; block++){
+			long long begin= std::max(block*(long long)block_size, series.m_total - (long long)m_capacity);
+			float low= FLT_MAX, high= -FLT_MAX;
+			ScanSamples(series, begin, std::min((block + 1)*(long long)block_size, series.m_total), low, high);
+			size_t slot= (size_t)block & (series.m_block_low.size() - 1);
+			series.m_block_low[slot]= low;
+			series.m_block_high[slot]= high;
+		}
+		m_is_dirty= true;
+	}
 
-		m_r= color.r;
-		m_g= color.g;
-		m_b= color.b;
-		m_a= color.a;
+	void SetRange(float min, float max){
+		m_min= min;
+		m_max= max;
+		m_is_dirty= true;
 	}
 
-	void CompleteCalculation(){
-		m_slider_size= {m_size.x/4, font_size};
-		m_pos_r= {m_position.x + (m_size.x/4)*3, m_position.y + font_size + element_padding};
-		m_pos_g= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*2 + element_padding*2};
-		m_pos_b= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*3 + element_padding*3};
-		m_pos_a= {m_position.x + (m_size.x/4)*3, m_position.y + font_size*4 + element_padding*4};
+	long long GetTotal(int index) const{ return m_series[index].m_total; }
+	size_t GetCapacity() const{ return m_capacity; }
 
-		m_rec_r= {m_pos_r.x, m_pos_r.y, m_slider_size.x, m_slider_size.y};
-		m_rec_g= {m_pos_g.x, m_pos_g.y, m_slider_size.x, m_slider_size.y};
-		m_rec_b= {m_pos_b.x, m_pos_b.y, m_slider_size.x, m_slider_size.y};
-		m_rec_a= {m_pos_a.x, m_pos_a.y, m_slider_size.x, m_slider_size.y};
+	float MeasureHeight(float width) override{
+		return (float)(m_rows*font_size);
 	}
 
 	void Update() override{
-		if(!m_calculated) CompleteCalculation();
+		if(IsMouseOver() && ui_input.m_wheel!= 0){
+			long long window= GetWindow();
+			window= (ui_input.TakeWheel()> 0) ? window/2 : window*2;
+			//a plot wider than its capacity has crossed bounds, which std::clamp doesn't allow. the capacity wins
+			m_window= std::min(std::max(window, (long long)std::max(2.0f, m_size.x)), (long long)m_capacity);
+			m_is_dirty= true;
+		}
+	}
 
-		if(IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			if(IsMouseOverEx(m_pos_r, m_slider_size)){
-				m_is_active_r= true;
-				m_is_active_g= false;	
-				m_is_active_b= false;	
-				m_is_active_a= false;	
-			}
-			else if((!IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) || IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_ENTER))		m_is_active_r= false;
+	void Draw() override{
+		Rectangle rec= {m_position.x, m_position.y, m_size.x, m_size.y};
+		ui_draw_list->AddRect(rec, ui_element_body);
+		if(rec.width< 1 || rec.height< 1) return;
+
+		long long columns= (long long)rec.width;
+		long long window= GetWindow();
+		long long bucket_size= std::max(1LL, (window + columns - 1)/columns);
+		//whole blocks, so reducing a bucket again never has to look at its samples
+		if(bucket_size> (long long)block_size) bucket_size= (bucket_size + block_size - 1)/block_size*block_size;
+
+		float low= FLT_MAX, high= -FLT_MAX;
+		for(Series& series : m_series) Reduce(series, window, bucket_size, columns, low, high);
+		if(m_min< m_max){
+			low= m_min;
+			high= m_max;
+		}
+		if(low> high){
+			low= 0.0f;
+			high= 1.0f;
+		}
+		if(low== high){
+			low-= 1.0f;
+			high+= 1.0f;
+		}
 
-			if(IsMouseOverEx(m_pos_g, m_slider_size)){
-				m_is_active_r= false;
-				m_is_active_g= true;	
-				m_is_active_b= false;	
-				m_is_active_a= false;	
+		float scale= (rec.height - 2)/(high - low);
+		float bottom= rec.y + rec.height - 1;
+		for(Series& series : m_series){
+			long long start= GetStart(series, window);
+			if(series.m_total<= start) continue;
+			long long first= start/bucket_size, end= (series.m_total + bucket_size - 1)/bucket_size;
+			size_t slots= series.m_low.size();
+			m_line.clear();
+			float previous= bottom;
+			for(long long bucket= first; bucket< end; bucket++){
+				float x= rec.x + rec.width - (float)(series.m_total - std::max(bucket*bucket_size, start))*rec.width/window;
+				float y_low= std::clamp(bottom - (series.m_low[bucket % slots] - low)*scale, rec.y, bottom);
+				float y_high= std::clamp(bottom - (series.m_high[bucket % slots] - low)*scale, rec.y, bottom);
+				//the end nearer to where the line comes from goes first, so columns do not cross over
+				if(std::fabs(y_high - previous)< std::fabs(y_low - previous)) std::swap(y_low, y_high);
+				m_line.push_back((Vector2){x, y_low});
+				if(y_high!= y_low) m_line.push_back((Vector2){x, y_high});
+				previous= y_high;
 			}
-			else if((!IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) || IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_ENTER))		m_is_active_g= false;
+			ui_draw_list->AddPolyline(m_line.data(), (int)m_line.size(), m_thickness, series.m_color);
+		}
 
-			if(IsMouseOverEx(m_pos_b, m_slider_size)){
-				m_is_active_r= false;
-				m_is_active_g= false;	
-				m_is_active_b= true;	
-				m_is_active_a= false;	
-			}
-			else if((!IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) || IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_ENTER))		m_is_active_b= false;
+		//legend and range, the range labels are laid out into reused runs since they change with the data
+		float x= rec.x + element_padding;
+		for(Series& series : m_series){
+			const TextRun& label= series.m_label.Get(m_font, series.m_name);
+			DrawTextRun(m_font, label, (Vector2){(float)static_cast<int>(x), rec.y}, series.m_color);
+			x+= label.m_size.x + 3*element_padding;
+		}
+		char text[32];
+		ValueBuffer buffer;
+		std::string_view value= format_float(buffer, high);
+		snprintf(text, sizeof(text), "%.*s", (int)value.size(), value.data());
+		TextCache::Layout(m_font, text, font_size, text_spacing, m_high_run);
+		value= format_float(buffer, low);
+		snprintf(text, sizeof(text), "%.*s", (int)value.size(), value.data());
+		TextCache::Layout(m_font, text, font_size, text_spacing, m_low_run);
+		DrawTextRun(m_font, m_high_run, (Vector2){(float)static_cast<int>(rec.x + rec.width - m_high_run.m_size.x - element_padding), rec.y}, ui_text_light);
+		DrawTextRun(m_font, m_low_run, (Vector2){(float)static_cast<int>(rec.x + rec.width - m_low_run.m_size.x - element_padding), rec.y + rec.height - font_size}, ui_text_light);
+	}
 
-			if(IsMouseOverEx(m_pos_a, m_slider_size)){
-				m_is_active_r= false;
-				m_is_active_g= false;	
-				m_is_active_b= false;	
-				m_is_active_a= true;	
-			}
-			else if((!IsMouseOver() && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) || IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_ENTER))		m_is_active_a= false;
+private:
+	size_t m_capacity= 1;
+	std::vector<Vector2> m_line;
+	TextRun m_high_run;
+	TextRun m_low_run;
+
+	long long GetWindow() const{
+		return (m_window> 0) ? std::min(m_window, (long long)m_capacity) : (long long)m_capacity;
+	}
+
+	//oldest sample shown
+	long long GetStart(const Series& series, long long window) const{
+		return std::max(0LL, series.m_total - window);
+	}
+
+	//brings the buckets of the visible window up to date and widens low and high by them
+	void Reduce(Series& series, long long window, long long bucket_size, long long columns, float& low, float& high){
+		size_t slots= (size_t)columns + 2;
+		if(series.m_bucket_size!= bucket_size || series.m_window!= window || series.m_low.size()!= slots){
+			series.m_low.assign(slots, 0.0f);
+			series.m_high.assign(slots, 0.0f);
+			series.m_bucket_size= bucket_size;
+			series.m_window= window;
+			series.m_done= 0;
 		}
+		long long start= GetStart(series, window);
+		if(series.m_total<= start) return;
+		long long first= start/bucket_size, end= (series.m_total + bucket_size - 1)/bucket_size;
+		//the first bucket loses samples as the window moves on
+		for(long long bucket= first; bucket< end; bucket++){
+			if(bucket< series.m_done && bucket*bucket_size>= start) continue;
+			float bucket_low= FLT_MAX, bucket_high= -FLT_MAX;
+			MinMax(series, std::max(bucket*bucket_size, start), std::min((bucket + 1)*bucket_size, series.m_total), bucket_low, bucket_high);
+			series.m_low[bucket % slots]= bucket_low;
+			series.m_high[bucket % slots]= bucket_high;
+		}
+		series.m_done= series.m_total/bucket_size;
 
-		updateSlider(&m_r, IsMouseOverEx(m_pos_r, m_slider_size), m_is_active_r, 1, 0, 255, 3);
-		updateSlider(&m_g, IsMouseOverEx(m_pos_g, m_slider_size), m_is_active_g, 1, 0, 255, 3);
-		updateSlider(&m_b, IsMouseOverEx(m_pos_b, m_slider_size), m_is_active_b, 1, 0, 255, 3);
-		updateSlider(&m_a, IsMouseOverEx(m_pos_a, m_slider_size), m_is_active_a, 1, 0, 255, 3);
+		for(long long bucket= first; bucket< end; bucket++){
+			low= std::min(low, series.m_low[bucket % slots]);
+			high= std::max(high, series.m_high[bucket % slots]);
+		}
+	}
 
-		m_color->r= m_r;
-		m_color->g= m_g;
-		m_color->b= m_b;
-		m_color->a= m_a;
+	//samples [from, to): the whole blocks inside from their summaries, the ends from the samples
+	void MinMax(const Series& series, long long from, long long to, float& low, float& high) const{
+		long long block= (long long)block_size;
+		long long head= std::min(to, (from + block - 1)/block*block);
+		long long tail= std::max(head, to/block*block);
+		ScanSamples(series, from, head, low, high);
+		size_t blocks= series.m_block_low.size();
+		for(long long first= head/block, end= tail/block; first< end;){
+			size_t begin= (size_t)first & (blocks - 1);
+			size_t span= std::min((size_t)(end - first), blocks - begin);
+			float unused= -FLT_MAX;
+			MinMax(series.m_block_low.data() + begin, span, low, unused);
+			unused= FLT_MAX;
+			MinMax(series.m_block_high.data() + begin, span, unused, high);
+			first+= (long long)span;
+		}
+		ScanSamples(series, tail, to, low, high);
 	}
 
-	void Draw() override{
-		std::string str;
-		DrawRectangleGradientH(m_position.x, m_position.y, m_size.x/2- element_padding*3, m_size.y, WHITE, *m_color);
-		DrawRectangleGradientV(m_position.x, m_position.y, m_size.x/2- element_padding*3, m_size.y, (Color){0, 0, 0, 0}, BLACK);
-
-		Vector2 pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/4)*3 - MeasureText(m_text.c_str(), font_size)/2), (float)static_cast<int>(m_position.y + m_slider_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, m_text.c_str(), pos_text, font_size, 2.0f, ui_text_light);
-
-		DrawRectangleRounded(m_rec_r, 0.3f, 2, (m_is_active_r) ? ui_element_hover : ui_element_body);
-		pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/8)*5 - MeasureText("R", font_size)/2), (float)static_cast<int>(m_pos_r.y + m_slider_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, "R", pos_text, font_size, 2.0f, ui_text_light);
-		str= to_string(m_r);
-		pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/8)*7 - MeasureText(str.c_str(), font_size)/2), (float)static_cast<int>(m_pos_r.y + m_slider_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, str.c_str(), pos_text, font_size, 2.0f, ui_text_light);
-
-		DrawRectangleRounded(m_rec_g, 0.3f, 2, (m_is_active_g) ? ui_element_hover : ui_element_body);
-		pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/8)*5 - MeasureText("G", font_size)/2), (float)static_cast<int>(m_pos_g.y + m_slider_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, "G", pos_text, font_size, 2.0f, ui_text_light);
-		str= to_string(m_g);
-		pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/8)*7 - MeasureText(str.c_str(), font_size)/2), (float)static_cast<int>(m_pos_g.y + m_slider_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, str.c_str(), pos_text, font_size, 2.0f, ui_text_light);
-
-		DrawRectangleRounded(m_rec_b, 0.3f, 2, (m_is_active_b) ? ui_element_hover : ui_element_body);
-		pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/8)*5 - MeasureText("B", font_size)/2), (float)static_cast<int>(m_pos_b.y + m_slider_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, "B", pos_text, font_size, 2.0f, ui_text_light);
-		str= to_string(m_b);
-		pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/8)*7 - MeasureText(str.c_str(), font_size)/2), (float)static_cast<int>(m_pos_b.y + m_slider_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, str.c_str(), pos_text, font_size, 2.0f, ui_text_light);
-
-		DrawRectangleRounded(m_rec_a, 0.3f, 2, (m_is_active_a) ? ui_element_hover : ui_element_body);
-		pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/8)*5 - MeasureText("A", font_size)/2), (float)static_cast<int>(m_pos_a.y + m_slider_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, "A", pos_text, font_size, 2.0f, ui_text_light);
-		str= to_string(m_a);
-		pos_text= { (float)static_cast<int>(m_position.x + (m_size.x/8)*7 - MeasureText(str.c_str(), font_size)/2), (float)static_cast<int>(m_pos_a.y + m_slider_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, str.c_str(), pos_text, font_size, 2.0f, ui_text_light);
+	//samples [from, to) of the ring, in at most two contiguous spans
+	void ScanSamples(const Series& series, long long from, long long to, float& low, float& high) const{
+		while(from< to){
+			size_t begin= (size_t)from & (m_capacity - 1);
+			size_t span= std::min((size_t)(to - from), m_capacity - begin);
+			MinMax(series.m_samples.data() + begin, span, low, high);
+			from+= (long long)span;
+		}
+	}
+
+	//eight independent lanes and selects instead of branches, so the compiler turns the loop into vector min/max.
+	//NaN samples never win a comparison and are skipped
+	static void MinMax(const float *values, size_t count, float& low, float& high){
+		float lanes_low[8], lanes_high[8];
+		for(int k= 0; k< 8; k++){
+			lanes_low[k]= low;
+			lanes_high[k]= high;
+		}
+		size_t i= 0;
+		for(; i + 8<= count; i+= 8){
+			for(int k= 0; k< 8; k++){
+				float value= values[i + k];
+				lanes_low[k]= (value< lanes_low[k]) ? value : lanes_low[k];
+				lanes_high[k]= (value> lanes_high[k]) ? value : lanes_high[k];
+			}
+		}
+		for(; i< count; i++){
+			low= (values[i]< low) ? values[i] : low;
+			high= (values[i]> high) ? values[i] : high;
+		}
+		for(int k= 0; k< 8; k++){
+			low= std::min(low, lanes_low[k]);
+			high= std::max(high, lanes_high[k]);
+		}
 	}
 };
 
-class Panel: public GuiElement{//_____________________________________________________________________ PANEL ________________________________________________________________________________//
+//a panel for large lists of buttons, checkboxes and sliders that keeps them as arrays per type instead of GuiElement objects.
+//update and draw run one loop per type over contiguous rects, labels and bound pointers, without virtual calls.
+//every row is font_size tall, so hover and the visible range come straight from the scroll offset
+class BucketPanel: public Panel{
 public:
-	std::vector<std::shared_ptr<GuiElement>> m_elements;
-	Font m_custom_font= GetFontDefault();
-	int m_header_size= font_size;
-	bool m_is_minimized= false;
-	bool m_is_moving= false;
-	int m_grid_size= grid_size;
-	int m_sections= 1;
-	bool m_has_header= true;
-	int m_counter= 0;
+	enum BucketKind{ BUCKET_NONE, BUCKET_BUTTON, BUCKET_CHECKBOX, BUCKET_SLIDER };
+
+	//shared by every bucket, rects are relative to the panel's left edge and the top of the unscrolled content
+	struct Bucket{
+		std::vector<int> m_slots;		//grid slot of every entry, ascending
+		std::vector<Rectangle> m_rects;
+		std::vector<std::string> m_texts;
+		std::vector<CachedText> m_labels;
+
+		void Add(int slot, Rectangle rect, const std::string& text){
+			m_slots.push_back(slot);
+			m_rects.push_back(rect);
+			m_texts.push_back(text);
+			m_labels.emplace_back();
+		}
 
-	Panel(std::string text, Vector2 position, Vector2 size){
-		m_text= text;
-		SetPosition( (Vector2){position.x * m_grid_size, position.y * m_grid_size} );
-		SetSize( (Vector2){size.x * m_grid_size, size.y * m_grid_size} );
+		//entries whose slot is in [first, last)
+		void Range(int first, int last, int& begin, int& end) const{
+			begin= (int)(std::lower_bound(m_slots.begin(), m_slots.end(), first) - m_slots.begin());
+			end= (int)(std::lower_bound(m_slots.begin() + begin, m_slots.end(), last) - m_slots.begin());
+		}
+	};
+
+	struct ButtonBucket: Bucket{
+		std::vector<std::function<void()>> m_call_backs;
+		std::vector<unsigned char> m_is_special;
+	};
+
+	//values are bound like the standalone widgets, m_values holds the copies the rows show and edit
+	struct CheckBoxBucket: Bucket{
+		std::vector<Binding<bool>> m_targets;
+		std::vector<unsigned char> m_values;
+		std::vector<unsigned char> m_drawn_values;
+		std::vector<CachedText> m_value_labels;
+	};
+
+	struct SliderBucket: Bucket{
+		std::vector<Binding<int>> m_targets;
+		std::vector<int> m_values;
+		std::vector<int> m_steps;
+		std::vector<int> m_mins;
+		std::vector<int> m_maxs;
+		std::vector<int> m_drawn_values;
+		std::vector<CachedText> m_value_labels;
+		int m_active= -1;
+	};
+
+	ButtonBucket m_buttons;
+	CheckBoxBucket m_checkboxes;
+	SliderBucket m_sliders;
+	std::vector<unsigned char> m_slot_kinds;
+	std::vector<int> m_slot_indices;
+
+	int m_hover_kind= BUCKET_NONE;
+	int m_hover_index= -1;
+	bool m_hover_pressed= false;
+	int m_drawn_hover_kind= BUCKET_NONE;
+	int m_drawn_hover_index= -1;
+	bool m_drawn_hover_pressed= false;
+	int m_drawn_active= -1;
+	float m_laid_out_width= 0.0f;
+
+	using Panel::Panel;
+
+	void addButton(const std::string& text, std::function<void()> call_back_function, bool is_special= false){
+		int slot= NextSlot(BUCKET_BUTTON, (int)m_buttons.m_slots.size());
+		m_buttons.Add(slot, SlotRect(slot), text);
+		m_buttons.m_call_backs.push_back(call_back_function);
+		m_buttons.m_is_special.push_back(is_special);
 	}
 
-	Panel(std::string text, Vector2 position, Vector2 size, Font custom_font){
-		m_text= text;
-		SetPosition( (Vector2){position.x * m_grid_size, position.y * m_grid_size} );
-		SetSize( (Vector2){size.x * m_grid_size, size.y * m_grid_size} );
-		m_custom_font= custom_font;
+	void addCheckBox(const std::string& text, Binding<bool> is_true){
+		int slot= NextSlot(BUCKET_CHECKBOX, (int)m_checkboxes.m_slots.size());
+		m_checkboxes.Add(slot, SlotRect(slot), text);
+		m_checkboxes.m_targets.push_back(is_true);
+		m_checkboxes.m_values.push_back(is_true.Load());
+		m_checkboxes.m_drawn_values.push_back(m_checkboxes.m_values.back());
+		m_checkboxes.m_value_labels.emplace_back();
 	}
 
-	Panel(std::string text, Vector2 position, Vector2 size, int sections, Font custom_font){
-		m_text= text;
-		SetPosition( (Vector2){position.x * m_grid_size, position.y * m_grid_size} );
-		SetSize( (Vector2){size.x * m_grid_size, size.y * m_grid_size} );
-		m_sections= sections;
-		m_custom_font= custom_font;
+	void addSlider(const std::string& text, Binding<int> target_val, int step_size= 1, int min= -INT_MAX, int max= INT_MAX){
+		int slot= NextSlot(BUCKET_SLIDER, (int)m_sliders.m_slots.size());
+		m_sliders.Add(slot, SlotRect(slot), text);
+		m_sliders.m_targets.push_back(target_val);
+		m_sliders.m_values.push_back(target_val.Load());
+		m_sliders.m_steps.push_back(step_size);
+		m_sliders.m_mins.push_back(min);
+		m_sliders.m_maxs.push_back(max);
+		m_sliders.m_drawn_values.push_back(m_sliders.m_values.back());
+		m_sliders.m_value_labels.emplace_back();
 	}
 
-	Panel(std::string text, Vector2 position, Vector2 size, bool has_header, int sections, Font custom_font){
-		m_text= text;
-		SetPosition( (Vector2){position.x * m_grid_size, position.y * m_grid_size} );
-		SetSize( (Vector2){size.x * m_grid_size, size.y * m_grid_size} );
-		m_has_header= has_header;
-		m_sections= sections;
-		m_custom_font= custom_font;
+	size_t GetEntryCount() const{
+		return m_slot_kinds.size();
 	}
 
-	void Update() override{
-		if(m_has_header){
-			if(IsMouseOverEx(m_position, (Vector2){m_size.x, (float)m_header_size}) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-				m_is_minimized= !m_is_minimized;
-			}
-			if(m_is_moving== false && IsMouseOverEx(m_position, (Vector2){m_size.x, (float)m_header_size}) && IsMouseButtonPressed(MOUSE_BUTTON_MIDDLE)){
-				m_is_moving= true;
-			}
-			else if(m_is_moving== true && (IsKeyPressed(KEY_ESCAPE) || IsMouseButtonPressed(MOUSE_BUTTON_MIDDLE))){
-				Vector2 fixedPos;
-				fixedPos.x= (int)(m_position.x / m_grid_size);
-				fixedPos.y= (int)(m_position.y / m_grid_size);
+	float RowHeight() const{
+		return (float)(font_size + element_padding);
+	}
 
-				fixedPos.x= ( ((fixedPos.x *m_grid_size) -m_position.x) *(-1) < (((fixedPos.x + 1) *m_grid_size) -m_position.x )) ? fixedPos.x *m_grid_size : (fixedPos.x + 1) *m_grid_size;
-				fixedPos.y= ( ((fixedPos.y *m_grid_size) -m_position.y) *(-1) < (((fixedPos.y + 1) *m_grid_size) -m_position.y )) ? fixedPos.y *m_grid_size : (fixedPos.y + 1) *m_grid_size;
-					Vector2 delta;
-				delta.x= fixedPos.x -m_position.x;
-				delta.y= fixedPos.y -m_position.y;
+	//Panel scrolls it like any other panel, it only has to know how tall the rows are
+	float ContentHeight() const override{
+		int rows= ((int)m_slot_kinds.size() + m_sections - 1)/m_sections;
+		return rows*RowHeight();
+	}
 
-				m_position= fixedPos;
+	//the rows take their input before Panel::Update(), so an active slider gets the wheel instead of the scroll
+	void Update() override{
+		if(!m_is_minimized) UpdateRows();
+		Panel::Update();
+	}
 
-				for(auto &element: m_elements){
-					element->m_position.x+= delta.x;
-					element->m_position.y+= delta.y;
-				}
-				m_is_moving= false;
-			}
+	void FocusChanged(bool is_focused) override{
+		if(!is_focused) m_sliders.m_active= -1;
+	}
 
-			if(m_is_moving){
-				Vector2 delta= GetMouseDelta();
-				m_position.x+= delta.x;
-				m_position.y+= delta.y;
+	void UpdateRows(){
+		Relayout();
+		ResolveHover();
 
-				for(auto &element: m_elements){
-					element->m_position.x+= delta.x;
-					element->m_position.y+= delta.y;
-				}
+		if(ui_input.IsPressed(MOUSE_BUTTON_LEFT)){
+			if(m_hover_kind== BUCKET_BUTTON && m_buttons.m_call_backs[m_hover_index]){
+				m_buttons.m_call_backs[m_hover_index]();
+			}
+			else if(m_hover_kind== BUCKET_CHECKBOX){
+				unsigned char& value= m_checkboxes.m_values[m_hover_index];
+				value= !value;
+				m_checkboxes.m_targets[m_hover_index].Store(value!= 0);
 			}
+			m_sliders.m_active= (m_hover_kind== BUCKET_SLIDER) ? m_hover_index : -1;
+			//typed digits go to the active slider, not to whatever had the focus before
+			if(m_sliders.m_active>= 0) ui_focus.SetFocus(this);
+		}
+		else if(ui_input.IsKeyPressed(KEY_ESCAPE) || ui_input.IsKeyPressed(KEY_ENTER)){
+			ui_focus.ClearFocus(this);
+			m_sliders.m_active= -1;
 		}
 
-		if(m_is_minimized== false){
-			for(auto& element : m_elements){
-				if(element->m_is_visible && (element->m_position.y + element->m_size.y)< (m_position.y + m_size.y))
-					element->Update();
-			}
-		}
-
-		float wheel_delta= GetMouseWheelMove();
-
-		if(m_is_minimized==false && IsMouseOver() && wheel_delta!= 0){
-			float delta= 0;
-			if(wheel_delta< 0){
-				for(int i= 0; i< m_sections; i++){
-					bool changed_first_element= false;
-					for(int j= i; j< (int)m_elements.size(); j+= m_sections){
-						if(changed_first_element== false && m_elements[j]->m_is_visible== true){
-							delta= m_elements[j]->m_size.y +element_padding;
-							m_elements[j]->m_is_visible= false;
-							m_elements[j]->m_position.y-= delta;
-							changed_first_element= true;
-						}
-						if(m_elements[j]->m_is_visible== true)
-							m_elements[j]->m_position.y-= delta;
-					}
-				}
-			}
-			else if(wheel_delta> 0){
-				for(int i= 0; i< m_sections; i++){
-					int counter= 0;
-					for(int j= i; j< (int)m_elements.size(); j+= m_sections){
-						if(m_elements[j]->m_is_visible== false){
-							counter++;
-						}
-					}
-					if(counter> 0){
-						delta= m_elements[i +m_sections *(counter -1)]->m_size.y +element_padding;
-						m_elements[i +m_sections *(counter -1)]->m_is_visible= true;
-						for(int k= i; k<(int)m_elements.size(); k+= m_sections){
-							if(m_elements[k]->m_is_visible== true)
-								m_elements[k]->m_position.y+= delta;
-						}
-					}
-				}
+		int active= m_sliders.m_active;
+		if(active>= 0){
+			int& value= m_sliders.m_values[active];
+			m_sliders.m_targets[active].Sync(value);
+			int previous= value;
+			updateSlider(&value, m_hover_kind== BUCKET_SLIDER && m_hover_index== active, true,
+				m_sliders.m_steps[active], m_sliders.m_mins[active], m_sliders.m_maxs[active]);
+			if(value!= previous) m_sliders.m_targets[active].Store(value);
+		}
+
+		//bound values can change from outside, the sliders on screen keep them in range like Slider::Update does.
+		//they are only written when that changes them
+		int first, last, begin, end;
+		VisibleSlots(first, last);
+		m_sliders.Range(first, last, begin, end);
+		Binding<int> *targets= m_sliders.m_targets.data();
+		int *values= m_sliders.m_values.data();
+		const int *mins= m_sliders.m_mins.data();
+		const int *maxs= m_sliders.m_maxs.data();
+		for(int i= begin; i< end; i++){
+			targets[i].Sync(values[i]);
+			int clamped= std::max(mins[i], std::min(values[i], maxs[i]));
+			if(clamped!= values[i]){
+				values[i]= clamped;
+				targets[i].Store(clamped);
 			}
 		}
 	}
 
 	void Draw() override{
-		if(m_is_minimized== false){
-			Color tempColor= m_has_header ? ui_panel_body : ui_panel_header;
-			DrawRectangle(static_cast<int>(m_position.x), static_cast<int>(m_position.y), static_cast<int>(m_size.x), static_cast<int>(m_size.y), tempColor);
-			DrawRectangleLines(static_cast<int>(m_position.x), static_cast<int>(m_position.y), static_cast<int>(m_size.x), static_cast<int>(m_size.y), ui_panel_header);
-			for(auto& element : m_elements){
-				if(element->m_is_visible && (element->m_position.y + element->m_size.y)< (m_position.y + m_size.y) && (element-> m_position.y > m_position.y))
-					element->Draw();
-			}
-		}
-		if(m_has_header){
-			DrawRectangle(static_cast<int>(m_position.x), static_cast<int>(m_position.y), static_cast<int>(m_size.x), static_cast<int>(m_header_size), ui_panel_header);
-			Vector2 pos= { (float)static_cast<int>(m_position.x + element_padding), (float)static_cast<int>(m_position.y + m_header_size/2 - font_size/2.5)};
-			DrawTextEx(m_custom_font, m_text.c_str(), pos, font_size, 2.0f, ui_text_highl);
+		if(!m_is_minimized){
+			Relayout();
+			ResolveHover();
+			if(ContentsChanged()) m_is_dirty= true;
 		}
+		Panel::Draw();
 	}
 
-	template <typename T>
-	void addElement(std::shared_ptr<T> element){
-		static_assert(std::is_base_of<GuiElement, T>::value, "Element must derive from GuiElement");
-
-		if(m_counter>= m_sections){
-			m_counter= 0;
+	//the types never overlap, so drawing them bucket by bucket layers the same as drawing them in slot order
+	void DrawElements() override{
+		int first, last;
+		VisibleSlots(first, last);
+		Vector2 origin= Origin();
+		float text_offset= font_size/2.5f;
+		bool is_pressed= ui_input.IsPressed(MOUSE_BUTTON_LEFT);
+
+		int begin, end;
+		m_buttons.Range(first, last, begin, end);
+		for(int i= begin; i< end; i++){
+			Rectangle rec= Offset(m_buttons.m_rects[i], origin);
+			bool is_hovered= (m_hover_kind== BUCKET_BUTTON && m_hover_index== i);
+			Color color;
+			if(m_buttons.m_is_special[i]) color= is_hovered ? (is_pressed ? ui_element_click : ui_special_h) : ui_special;
+			else color= is_hovered ? (is_pressed ? ui_element_click : ui_element_hover) : ui_element_body;
+			ui_draw_list->AddRectRounded(rec, 0.3f, 2, color);
+
+			const TextRun& label= m_buttons.m_labels[i].Get(m_custom_font, m_buttons.m_texts[i]);
+			Vector2 pos= {(float)static_cast<int>(rec.x + rec.width/2 - label.m_size.x/2), (float)static_cast<int>(rec.y + rec.height/2 - text_offset)};
+			DrawTextRun(m_custom_font, label, pos, m_buttons.m_is_special[i] ? ui_panel_header : ui_text_light);
 		}
 
-		Vector2 newPosition= m_position;
-		newPosition.x+= element_padding *2 +(m_counter *(m_size.x/ m_sections));
-		newPosition.y+= (m_has_header ? element_padding +font_size : element_padding);
-		int group= 0;
-		for(const auto& elem : m_elements){
-			if(group== m_counter)
-				newPosition.y+= elem->m_size.y +element_padding;
-			
-			group++;
-			if(group== m_sections) group= 0;
-		}
+		m_checkboxes.Range(first, last, begin, end);
+		for(int i= begin; i< end; i++){
+			Rectangle rec= Offset(m_checkboxes.m_rects[i], origin);
+			bool is_hovered= (m_hover_kind== BUCKET_CHECKBOX && m_hover_index== i);
+			ui_draw_list->AddRectRounded((Rectangle){rec.x + rec.width/2, rec.y, rec.width/2, rec.height}, 0.3f, 2, ui_element_body);
 
-		Vector2 newSize= m_size;
-		newSize.x= m_size.x/m_sections;
-		newSize.x-= element_padding *4;
-		if constexpr (std::is_same<T, Thumbnail>::value || std::is_same<T, ThumbnailGif>::value){
-			newSize.y= font_size *2 + element_padding;
-		}
-		else if constexpr (std::is_same<T, Billboard>::value || std::is_same<T, BillboardGif>::value || std::is_same<T, CameraView3D>::value){
-			newSize.y= newSize.x;
-		}
-		else if constexpr (std::is_same<T, CameraView3DFill>::value){
-			newSize.y= m_size.y -(newPosition.y -m_position.y) -element_padding;
-		}
-		else if constexpr (std::is_same<T, CameraView3DFillBorder>::value){
-			newSize.y= m_size.y -(newPosition.y -m_position.y) -element_padding;
-		}
-		else if(std::is_same<T, ColorPicker>::value){
-			newSize.y= (font_size + element_padding) *5;
-		}
-		else{
-			newSize.y= font_size;
+			//each run is drawn before the next one is looked up, like CheckBox::Draw
+			DrawValue(rec, m_checkboxes.m_value_labels[i].Get(m_custom_font, b2s(m_checkboxes.m_values[i]!= 0)));
+			DrawLabel(rec, m_checkboxes.m_labels[i].Get(m_custom_font, m_checkboxes.m_texts[i]), is_hovered);
 		}
 
-		element->SetPosition(newPosition);
-		element->SetSize(newSize);
-		element->SetFont(m_custom_font);
-		m_elements.push_back(element);
+		m_sliders.Range(first, last, begin, end);
+		for(int i= begin; i< end; i++){
+			Rectangle rec= Offset(m_sliders.m_rects[i], origin);
+			bool is_hovered= (m_hover_kind== BUCKET_SLIDER && m_hover_index== i);
+			ui_draw_list->AddRectRounded((Rectangle){rec.x + rec.width/2, rec.y, rec.width/2, rec.height}, 0.3f, 2, (m_sliders.m_active== i) ? ui_element_hover : ui_element_body);
 
-		m_counter++;
+			ValueBuffer buffer;
+			DrawValue(rec, m_sliders.m_value_labels[i].Get(m_custom_font, format_int(buffer, m_sliders.m_values[i])));
+			DrawLabel(rec, m_sliders.m_labels[i].Get(m_custom_font, m_sliders.m_texts[i]), is_hovered);
+		}
 	}
 
-	void removeElement(std::shared_ptr<GuiElement> element){
-		m_elements.erase(std::remove(m_elements.begin(), m_elements.end(), element), m_elements.end());
+private:
+	int NextSlot(int kind, int index){
+		m_slot_kinds.push_back((unsigned char)kind);
+		m_slot_indices.push_back(index);
+		m_is_dirty= true;
+		return (int)m_slot_kinds.size() - 1;
 	}
-};
-
-//might add drop right and drop left menus
-class DropDown: public GuiElement{
-public:
-	bool m_is_selected= false;
-	int m_extra_width= 0;
-	int m_element_count= 0;
-	Vector2 m_panel_pos;
-	Vector2 m_panel_size;
-	std::shared_ptr<Panel> *m_panel;
 
-	DropDown(const std::string text, int extra_width, int element_count){
-		m_text= text;
-		m_extra_width= extra_width;
-		m_element_count= element_count;
+	Rectangle SlotRect(int slot) const{
+		float section_width= m_size.x/m_sections;
+		return (Rectangle){element_padding*2 + (slot % m_sections)*section_width, (slot / m_sections)*RowHeight(), section_width - element_padding*4, (float)font_size};
+	}
 
-		// m_panel= std::make_shared<Panel>("dropdown-panel", m_panel_pos, m_panel_size, false, 1, m_font);
+	//rects only depend on the width, moving the panel leaves them alone
+	void Relayout(){
+		if(m_laid_out_width== m_size.x) return;
+		m_laid_out_width= m_size.x;
+		for(size_t i= 0; i< m_buttons.m_slots.size(); i++) m_buttons.m_rects[i]= SlotRect(m_buttons.m_slots[i]);
+		for(size_t i= 0; i< m_checkboxes.m_slots.size(); i++) m_checkboxes.m_rects[i]= SlotRect(m_checkboxes.m_slots[i]);
+		for(size_t i= 0; i< m_sliders.m_slots.size(); i++) m_sliders.m_rects[i]= SlotRect(m_sliders.m_slots[i]);
+		m_is_dirty= true;
 	}
 
-	Vector2 GetPanelPos(){
-		Vector2 temp;
-		temp.x= m_panel_pos.x/20.0;
-		temp.y= m_panel_pos.y/20.0;
-		return temp;
+	Vector2 Origin() const{
+		return (Vector2){m_position.x, ContentTop() - m_scroll_offset};
 	}
 
-	Vector2 GetPanelSize(){
-		Vector2 temp;
-		temp.x= m_panel_size.x/20.0;
-		temp.y= m_panel_size.y/20.0;
-		return temp;
+	static Rectangle Offset(Rectangle rect, Vector2 origin){
+		return (Rectangle){(float)static_cast<int>(origin.x + rect.x), (float)static_cast<int>(origin.y + rect.y), rect.width, rect.height};
 	}
 
-	void PrintDimensions(){
-		static bool did_print= false;
-		if(!did_print){
-			Vector2 pos= GetPanelPos();
-			Vector2 size= GetPanelSize();
-			std::cout<<"pos x: "<<pos.x<<std::endl;
-			std::cout<<"pos y: "<<pos.y<<std::endl;
-			std::cout<<"size x: "<<size.x<<std::endl;
-			std::cout<<"size y: "<<size.y<<std::endl;
-			did_print= true;
-		}
-		//size.y is +0.85 for each element
+	//slots of the rows between the content top and the bottom of the panel, the ones cut by the edges are clipped
+	void VisibleSlots(int& first, int& last) const{
+		float view_height= m_position.y + m_size.y - ContentTop();
+		int first_row= std::max(0, (int)std::floor(m_scroll_offset/RowHeight()));
+		int last_row= (int)std::ceil((m_scroll_offset + view_height)/RowHeight());
+		first= first_row*m_sections;
+		last= std::max(first, last_row*m_sections);
 	}
 
-	void SetPanel(std::shared_ptr<Panel> &panel){
-		m_panel= &panel;
+	void ResolveHover(){
+		m_hover_kind= BUCKET_NONE;
+		m_hover_index= -1;
+		m_hover_pressed= false;
+		if(!IsMouseOver()) return;
+
+		Vector2 mouse= (ui_hover.m_generation!= 0) ? ui_hover.m_mouse : ui_backend->GetMousePosition();
+		if(!CheckCollisionPointRec(mouse, ContentClip())) return;
+		Vector2 origin= Origin();
+		int section= (int)((mouse.x - m_position.x)/(m_size.x/m_sections));
+		int row= (int)std::floor((mouse.y - origin.y)/RowHeight());
+		if(section< 0 || section>= m_sections || row< 0) return;
+
+		int slot= row*m_sections + section;
+		int first, last;
+		VisibleSlots(first, last);
+		if(slot< first || slot>= last || slot>= (int)m_slot_kinds.size()) return;
+
+		int kind= m_slot_kinds[slot];
+		int index= m_slot_indices[slot];
+		const Bucket& bucket= (kind== BUCKET_BUTTON) ? (const Bucket&)m_buttons : (kind== BUCKET_CHECKBOX) ? (const Bucket&)m_checkboxes : (const Bucket&)m_sliders;
+		if(CheckCollisionPointRec(mouse, Offset(bucket.m_rects[index], origin))){
+			m_hover_kind= kind;
+			m_hover_index= index;
+			m_hover_pressed= ui_input.IsPressed(MOUSE_BUTTON_LEFT);
+		}
 	}
 
-	void Update() override{
-		static int is_initialized= 0;
-		if(is_initialized <10){
-			m_panel_pos.x= m_position.x;
-			m_panel_pos.y= (m_position.y +font_size +element_padding);
-			m_panel_size.x= (m_size.x +m_extra_width);
-			m_panel_size.y= (element_padding +((font_size +element_padding) *m_element_count));
-			is_initialized++;
+	//compares what is on screen with what the cache holds, only the visible entries are checked
+	bool ContentsChanged(){
+		bool is_changed= false;
+		if(m_hover_kind!= m_drawn_hover_kind || m_hover_index!= m_drawn_hover_index || m_hover_pressed!= m_drawn_hover_pressed || m_sliders.m_active!= m_drawn_active){
+			m_drawn_hover_kind= m_hover_kind;
+			m_drawn_hover_index= m_hover_index;
+			m_drawn_hover_pressed= m_hover_pressed;
+			m_drawn_active= m_sliders.m_active;
+			is_changed= true;
 		}
 
-		if(IsMouseButtonPressed(MOUSE_BUTTON_LEFT)){
-			if(IsMouseOver()){
-				m_is_selected= !m_is_selected;
+		int first, last, begin, end;
+		VisibleSlots(first, last);
+		m_checkboxes.Range(first, last, begin, end);
+		for(int i= begin; i< end; i++){
+			if(m_checkboxes.m_targets[i].IsSettled()) m_checkboxes.m_values[i]= m_checkboxes.m_targets[i].Load();
+			unsigned char value= m_checkboxes.m_values[i];
+			if(value!= m_checkboxes.m_drawn_values[i]){
+				m_checkboxes.m_drawn_values[i]= value;
+				is_changed= true;
 			}
-			else if(!(m_is_selected && IsMouseOverEx(m_panel_pos, m_panel_size))){
-				m_is_selected= false;
+		}
+		m_sliders.Range(first, last, begin, end);
+		for(int i= begin; i< end; i++){
+			m_sliders.m_targets[i].Sync(m_sliders.m_values[i]);
+			int value= m_sliders.m_values[i];
+			if(value!= m_sliders.m_drawn_values[i]){
+				m_sliders.m_drawn_values[i]= value;
+				is_changed= true;
 			}
 		}
-		if(m_is_selected){
-			(*m_panel)->Update();
+		return is_changed;
+	}
+
+	//value centered in the right half of the row, label in the left half
+	void DrawValue(Rectangle rec, const TextRun& value){
+		float text_y= (float)static_cast<int>(rec.y + rec.height/2 - font_size/2.5f);
+		DrawTextRun(m_custom_font, value, (Vector2){(float)static_cast<int>(rec.x + rec.width/2 + rec.width/4 - value.m_size.x/2), text_y}, ui_text_light);
+	}
+	void DrawLabel(Rectangle rec, const TextRun& label, bool is_hovered){
+		float text_y= (float)static_cast<int>(rec.y + rec.height/2 - font_size/2.5f);
+		DrawTextRun(m_custom_font, label, (Vector2){(float)static_cast<int>(rec.x + rec.width/4 - label.m_size.x/2), text_y}, is_hovered ? ui_text_hover : ui_text_light);
+	}
+};
+
+#ifdef SWANGUI_PROFILE
+//shows what the profiler published: a frame time histogram, the costliest panels and the slowest elements
+class ProfilerView: public GuiElement{
+public:
+	static constexpr int max_lines= 16;
+	static constexpr int histogram_height= 48;
+	static constexpr int histogram_buckets= 32;		//one per millisecond, the last one collects everything slower
+	unsigned int m_drawn_version= 0;
+	int m_refresh_frames= 15;					//redraws at most every this many frames so the numbers stay readable
+	CachedText m_lines[max_lines];
+
+	bool FillsPanel() const override{ return true; }
+
+	void Update() override{}
+
+	bool CheckDirty() override{
+		if(Profiler::Get().m_version - m_drawn_version>= (unsigned int)m_refresh_frames){
+			m_drawn_version= Profiler::Get().m_version;
+			m_is_dirty= true;
 		}
+		return GuiElement::CheckDirty();
 	}
 
 	void Draw() override{
-		Color currentColor= IsMouseOver()  ? ui_element_hover : ui_element_body;
-
-		Rectangle rec= {static_cast<float>(m_position.x), static_cast<float>(m_position.y), static_cast<float>(m_size.x), static_cast<float>(m_size.y)};
-		DrawRectangleRounded(rec, 0.3f, 2, currentColor);
-		rec= {static_cast<float>(m_position.x +2), static_cast<float>(m_position.y +2), static_cast<float>(m_size.x -4), static_cast<float>(m_size.y -4)};
-		DrawRectangleRounded(rec, 0.3f, 2, ui_panel_body);
-		Vector2 pos= { (float)static_cast<int>(m_position.x + m_size.x/2 - MeasureText(m_text.c_str(), font_size)/2), (float)static_cast<int>(m_position.y + m_size.y/2 - font_size/2.5)};
-		DrawTextEx(m_font, m_text.c_str(), pos, font_size, 2.0f, ui_text_light);
+		const Profiler& profiler= Profiler::Get();
+
+		int buckets[histogram_buckets]= {0};
+		float total= 0.0f, slowest= 0.0f;
+		for(int i= 0; i< profiler.m_frame_count; i++){
+			float us= profiler.m_frame_us[i];
+			buckets[std::min((int)(us/1000.0f), histogram_buckets - 1)]++;
+			total+= us;
+			slowest= std::max(slowest, us);
+		}
+		int peak= std::max(1, *std::max_element(buckets, buckets + histogram_buckets));
+
+		float y= m_position.y;
+		int line= 0;
+		char text[128];
+		snprintf(text, sizeof(text), "frame avg %.2f ms  max %.2f ms", profiler.m_frame_count ? total/profiler.m_frame_count/1000.0f : 0.0f, slowest/1000.0f);
+		DrawRow(line++, text, y);
+
+		float bar_width= m_size.x/histogram_buckets;
+		ui_draw_list->AddRect((Rectangle){m_position.x, y, m_size.x, (float)histogram_height}, ui_element_body);
+		for(int i= 0; i< histogram_buckets; i++){
+			if(buckets[i]== 0) continue;
+			float height= (float)static_cast<int>(histogram_height*buckets[i]/(float)peak);
+			ui_draw_list->AddRect((Rectangle){(float)static_cast<int>(m_position.x + i*bar_width), y + histogram_height - height, std::max(1.0f, bar_width - 1), height}, (i< 16) ? ui_special : ui_element_click);
+		}
+		y+= histogram_height + element_padding;
 
-		Vector2 pos2= {(float)static_cast<int>(m_position.x + m_size.x -10), pos.y +5};
-		DrawTriangle( (Vector2){pos2.x, pos2.y}, (Vector2){pos2.x +3, pos2.y +5}, (Vector2){pos2.x +6, pos2.y}, ui_element_hover);
+		DrawRow(line++, "panels  (update / draw us)", y);
+		for(size_t i= 0; i< profiler.m_panels.size() && i< 5; i++){
+			const Profiler::PanelCost& cost= profiler.m_panels[i];
+			snprintf(text, sizeof(text), "  %-16.16s %8.1f %8.1f", cost.m_label.c_str(), cost.m_update_us, cost.m_draw_us);
+			DrawRow(line++, text, y);
+		}
 
-		if(m_is_selected){
-			(*m_panel)->Draw();
+		DrawRow(line++, "slowest elements  (us)", y);
+		for(const Profiler::Sample& sample : profiler.m_slowest){
+			if(line>= max_lines) break;
+			snprintf(text, sizeof(text), "  %-16.16s %-6s %8.1f", sample.m_label.c_str(), (sample.m_kind== ZONE_ELEMENT_UPDATE) ? "update" : "draw", sample.m_us);
+			DrawRow(line++, text, y);
 		}
 	}
+
+private:
+	void DrawRow(int line, const char *text, float& y){
+		if(line>= max_lines || y + font_size> m_position.y + m_size.y) return;
+		DrawTextRun(m_font, m_lines[line].Get(m_font, text), (Vector2){m_position.x, (float)static_cast<int>(y)}, ui_text_light);
+		y+= font_size + text_line_spacing;
+	}
+};
+
+//a panel holding a single ProfilerView that fills it
+class ProfilerPanel: public Panel{
+public:
+	std::shared_ptr<ProfilerView> m_view;
+
+	ProfilerPanel(Vector2 position, Vector2 size): Panel("Profiler", position, size){
+		m_view= std::make_shared<ProfilerView>();
+		addElement(m_view);
+	}
 };
+#endif
 
 class SwanGui{//_____________________________________________________________________________________ SWANGUI _______________________________________________________________________________//
 public:
 	std::vector<std::shared_ptr<Panel>> m_panels;
+	HitGrid m_hit_grid;
+	unsigned int m_hit_version= 0;
+	unsigned int m_hit_generation= 0;
+
+	//what Pace() does with frames that have nothing to show
+	enum IdlePacing{
+		PACING_OFF,			//every frame runs at the target frame rate
+		PACING_WAIT_EVENTS,	//EndDrawing() blocks until the next input event, nothing from other threads wakes it
+		PACING_THROTTLE		//idle frames are slowed down to m_idle_rate, for values that change from outside the gui
+	};
+	int m_idle_pacing= PACING_OFF;
+	float m_idle_rate= 10.0f;
+	bool m_is_waiting= false;
 
 	SwanGui(){}
 
@@ -1295,6 +5818,7 @@ public:
 		auto it= std::find(m_panels.begin(), m_panels.end(), panel);
 		if(it== m_panels.end()){
 			m_panels.push_back(panel);
+			ui_layout_version++;
 		}
 	}
 	void RemovePanel(std::shared_ptr<Panel> panel){
@@ -1302,17 +5826,110 @@ public:
 			std::remove(m_panels.begin(), m_panels.end(), panel), 
 			m_panels.end()
 		);
+		ui_layout_version++;
+	}
+
+	//rebuilds the hit index if the layout changed and finds the hovered panel and element once for the whole frame
+	void ResolveHover(){
+		if(m_hit_generation== 0 || m_hit_version!= ui_layout_version){
+			m_hit_generation++;
+			m_hit_grid.Clear();
+			for(int i= 0; i< (int)m_panels.size(); i++){
+				m_panels[i]->CollectHitRects(m_hit_grid, i, m_hit_generation);
+			}
+			m_hit_grid.Build();
+			m_hit_version= ui_layout_version;
+		}
+		ui_hover.m_generation= m_hit_generation;
+		ui_hover.m_mouse= ui_backend->GetMousePosition();
+		m_hit_grid.Query(ui_hover.m_mouse, ui_hover.m_panel, ui_hover.m_element);
+	}
+
+	GuiElement* GetHoveredElement() const{
+		return ui_hover.m_element;
+	}
+
+	//panels entirely off screen skip update and draw without touching their elements, unless they are being dragged
+	static bool IsOnScreen(const Panel& panel, Vector2 screen){
+		if(panel.m_is_moving || screen.x<= 0 || screen.y<= 0) return true;
+		Rectangle bounds= panel.GetBounds();
+		return bounds.x< screen.x && bounds.y< screen.y && bounds.x + bounds.width> 0 && bounds.y + bounds.height> 0;
 	}
 
+	//a frame starts here: the stats are reset and the backend's input is read once into ui_input
 	void Update(){
+		SWANGUI_ZONE(ZONE_GUI_UPDATE, nullptr);
+		ui_frame_stats= FrameStats();
+		TextCache::Get().EndFrame();
+		ui_input.Collect();
+		AssetLoader::Get().Upload(ui_upload_budget);
+		AnimationCache::Get().Tick();
+		ResolveHover();
+		if(ui_input.IsPressed(MOUSE_BUTTON_LEFT)) ui_focus.Click(ui_hover.m_element ? ui_hover.m_element : ui_hover.m_panel);
+		Vector2 screen= ui_backend->GetScreenSize();
 		for(auto& panel : m_panels){
-			panel->Update();
+			if(IsOnScreen(*panel, screen)) panel->Update();
 		}
+		//this frame's edits of shared values, the owner thread picks them up with ui_changes.Apply()
+		ui_changes.Publish();
 	}
 
 	void Draw(){
-		for(auto& panel : m_panels){
-			panel->Draw();
+		{
+			SWANGUI_ZONE(ZONE_GUI_DRAW, nullptr);
+			ResolveHover();
+			//every panel records into the frame list, it is submitted once all of them are done
+			DrawScope scope(ui_frame_list);
+			Vector2 screen= ui_backend->GetScreenSize();
+			for(auto& panel : m_panels){
+				if(IsOnScreen(*panel, screen)) panel->Draw();
+				else ui_frame_stats.panels_culled++;
+			}
+		}
+#ifdef SWANGUI_PROFILE
+		Profiler::Get().EndFrame();
+#endif
+	}
+
+	const FrameStats& GetFrameStats() const{
+		return ui_frame_stats;
+	}
+
+	bool IsAnimating() const{
+		if(AssetLoader::Get().GetPending()> 0) return true;		//uploads only happen in Update()
+		Vector2 screen= ui_backend->GetScreenSize();
+		for(const auto& panel : m_panels){
+			if(IsOnScreen(*panel, screen) && panel->IsAnimating()) return true;
+		}
+		return false;
+	}
+
+	//this frame's input, the frame after it still runs so that hover and focus changes get drawn
+	bool HasPendingInput() const{
+		return !ui_input.IsIdle();
+	}
+
+	//the next frame would look exactly like this one until there is input
+	bool IsIdle() const{
+		return !HasPendingInput() && !IsAnimating();
+	}
+
+	void SetIdlePacing(int pacing, float idle_rate= 10.0f){
+		m_idle_pacing= pacing;
+		m_idle_rate= idle_rate;
+	}
+
+	//call after Draw() and before EndDrawing(). with PACING_WAIT_EVENTS an idle frame makes EndDrawing() wait for input
+	//instead of rendering at the target frame rate, PACING_THROTTLE sleeps so idle frames come m_idle_rate times per second
+	void Pace(){
+		bool is_idle= m_idle_pacing!= PACING_OFF && IsIdle();
+		bool is_waiting= is_idle && m_idle_pacing== PACING_WAIT_EVENTS;
+		if(is_waiting!= m_is_waiting){
+			ui_backend->SetEventWaiting(is_waiting);
+			m_is_waiting= is_waiting;
+		}
+		if(is_idle && m_idle_pacing== PACING_THROTTLE && m_idle_rate> 0.0f){
+			ui_backend->WaitTime(1.0/m_idle_rate);
 		}
 	}
 };